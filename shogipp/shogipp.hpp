@@ -29,6 +29,26 @@
 #include <mutex>
 #include <future>
 #include <thread>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <deque>
+#include <condition_variable>
+
+/**
+ * @breif ы̗̕\ۂ BMI2  PEXT gpB
+ * @details ̃}N`ĂȂꍇA magic bitboard ɂgpB
+ *          BMI2 ߂p\ł邱ƂRpC画ꍇAIɒ`B
+ */
+#if !defined(SHOGIPP_USE_BMI2) && (defined(__BMI2__) || (defined(_MSC_VER) && defined(_M_X64) && defined(__AVX2__)))
+#define SHOGIPP_USE_BMI2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(SHOGIPP_USE_BMI2)
+#include <immintrin.h>
+#endif
 
 /*
 
@@ -44,13 +64,6 @@
         * ̗̍h炬ȂƏsIɂȂB
 */
 
-/**
- * @breif nbVl̃oCg`B
- * @details SIZE_OF_HASH % sizeof(std::size_t) == 0 łȂ΂ȂȂB
- *          ̃}N`ĂȂꍇAnbVlƂ std::size_t gpB
- */
-#define SIZE_OF_HASH 16
-
 //#define NONDETERMINISM
 #ifdef NONDETERMINISM
 #define SHOGIPP_SEED std::random_device{}()
@@ -113,6 +126,32 @@ namespace shogipp
     using pruning_threshold_t = unsigned int;
     using iddfs_iteration_t = unsigned int;
 
+    /**
+     * @breif ̃XbhɂT̕
+     */
+    enum class parallel_mode_t
+    {
+        lazy_smp,           // ⏕Xbhu\LēǖʂTB
+        ybwc,               // ZTAčZߓ_XbhԂŕSĒTB
+        deterministic_ybwc  // ybwc ƓlɕS邪AZߓ_𕪒S_̑ƌʂ̒u\ŒTAŒ[̒TʂXbh̎sɈˑȂB
+    };
+
+    /**
+     * @breif 𕡐̃XbhɂT̕ɕϊB
+     * @param name 
+     * @return ̃XbhɂT̕(ϊłȂꍇ std::nullopt)
+     */
+    inline std::optional<parallel_mode_t> to_parallel_mode(std::string_view name)
+    {
+        if (name == "lazy-smp" || name == "LazySMP")
+            return parallel_mode_t::lazy_smp;
+        if (name == "ybwc" || name == "YBWC")
+            return parallel_mode_t::ybwc;
+        if (name == "deterministic-ybwc" || name == "DeterministicYBWC")
+            return parallel_mode_t::deterministic_ybwc;
+        return std::nullopt;
+    }
+
     namespace details
     {
         SHOGIPP_STRING_LITERAL(split_tokens_literal, R"(\s+)");
@@ -197,16 +236,30 @@ namespace shogipp
              */
             inline const search_count_t & cache_hit_count() const noexcept;
 
+            /**
+             * @breif ɂ]ǖʐ̎QƂԂB
+             * @return ɂ]ǖʐ̎Q
+             */
+            inline search_count_t & repetition_count() noexcept;
+
+            /**
+             * @breif ɂ]ǖʐ̎QƂԂB
+             * @return ɂ]ǖʐ̎Q
+             */
+            inline const search_count_t & repetition_count() const noexcept;
+
         private:
             std::chrono::system_clock::time_point m_begin;
             search_count_t m_search_count;
             search_count_t m_cache_hit_count;
+            search_count_t m_repetition_count;
         };
 
         inline performance_t::performance_t() noexcept
             : m_begin{ std::chrono::system_clock::now() }
             , m_search_count{}
             , m_cache_hit_count{}
+            , m_repetition_count{}
         {
         }
 
@@ -250,6 +303,16 @@ namespace shogipp
             return m_cache_hit_count;
         }
 
+        inline search_count_t & performance_t::repetition_count() noexcept
+        {
+            return m_repetition_count;
+        }
+
+        inline const search_count_t & performance_t::repetition_count() const noexcept
+        {
+            return m_repetition_count;
+        }
+
         thread_local performance_t performance;
 
         /**
@@ -433,8 +496,27 @@ namespace shogipp
             const std::string default_piece_pair_statistics = "piece_pair_statistics.bin";
             std::string piece_pair_statistics = default_piece_pair_statistics;
 
-            constexpr std::size_t default_cache_size = 256 * 1000 * 1000;
+            constexpr std::size_t default_cache_size = 64; // [MB]
             std::size_t cache_size = default_cache_size;
+
+            constexpr unsigned int default_thread_number = 1;
+            unsigned int thread_number = default_thread_number;
+
+            constexpr parallel_mode_t default_parallel_mode = parallel_mode_t::lazy_smp;
+            parallel_mode_t parallel_mode = default_parallel_mode;
+
+            constexpr bool default_principal_variation_search = false;
+            bool principal_variation_search = default_principal_variation_search;
+
+            std::optional<move_count_t> perft_depth;
+
+            const unsigned int default_perft_thread_number = std::max(std::thread::hardware_concurrency(), 1u);
+            unsigned int perft_thread_number = default_perft_thread_number;
+
+            constexpr std::size_t default_perft_table_size = 64; // [MB]
+            std::size_t perft_table_size = default_perft_table_size;
+
+            std::optional<search_count_t> verify_checks_position_number;
         } // namespace program_options
 
         namespace evaluation_value_template
@@ -586,6 +668,7 @@ namespace shogipp
     constexpr piece_value_t promoted_bishop_value{ 0x0D };
     constexpr piece_value_t promoted_rook_value  { 0x0E };
     constexpr piece_value_t out_of_range_value   { 0xFF };
+    constexpr piece_value_t noncolored_piece_size{ promoted_rook_value + 1 };
 
     /**
      * @breif 𕶎ɕϊB
@@ -1138,19 +1221,7 @@ namespace shogipp
     */
     inline constexpr position_t position_to_position9x9(position_t position) noexcept
     {
-        class impl_t
-        {
-        public:
-            inline constexpr impl_t() noexcept
-            {
-                for (position_t rank = 0; rank < rank_size; ++rank)
-                    for (position_t file = 0; file < file_size; ++file)
-                        map[file_rank_to_position(file, rank)] = rank * file_size + file;
-            }
-            position_t map[position_size]{};
-        };
-        constexpr impl_t impl;
-        return impl.map[position];
+        return position_to_rank(position) * file_size + position_to_file(position);
     }
 
     /**
@@ -1163,6 +1234,292 @@ namespace shogipp
         return file_rank_to_position(static_cast<position_t>(position % file_size), static_cast<position_t>(position / file_size));
     }
 
+    namespace details
+    {
+        /**
+         * @breif 64rbg̍ŉʂ1łrbg̈ʒuԂB
+         * @param value 0 łȂ64rbg
+         * @return ŉʂ1łrbg̈ʒu
+         */
+        inline unsigned int count_trailing_zeros(std::uint64_t value) noexcept
+        {
+            SHOGIPP_ASSERT(value != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned int>(index);
+#elif defined(__GNUC__)
+            return static_cast<unsigned int>(__builtin_ctzll(value));
+#else
+            unsigned int index = 0;
+            while (!(value & 1))
+            {
+                value >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        /**
+         * @breif 64rbg̍ŏʂ1łrbg̈ʒuԂB
+         * @param value 0 łȂ64rbg
+         * @return ŏʂ1łrbg̈ʒu
+         */
+        inline unsigned int bit_scan_reverse(std::uint64_t value) noexcept
+        {
+            SHOGIPP_ASSERT(value != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<unsigned int>(index);
+#elif defined(__GNUC__)
+            return static_cast<unsigned int>(63 - __builtin_clzll(value));
+#else
+            unsigned int index = 0;
+            while (value >>= 1)
+                ++index;
+            return index;
+#endif
+        }
+
+        /**
+         * @breif 64rbg1łrbg̐ԂB
+         * @param value 64rbg
+         * @return 1łrbg̐
+         */
+        inline unsigned int population_count(std::uint64_t value) noexcept
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            return static_cast<unsigned int>(__popcnt64(value));
+#elif defined(__GNUC__)
+            return static_cast<unsigned int>(__builtin_popcountll(value));
+#else
+            unsigned int count = 0;
+            for (; value; value &= value - 1)
+                ++count;
+            return count;
+#endif
+        }
+
+        /**
+         * @breif 64rbg̉ʃrbg}XN1łrbg̈ʒuɕzĕԂB
+         * @param value 64rbg
+         * @param mask }XN
+         * @return zrbg
+         */
+        inline std::uint64_t parallel_bits_deposit(std::uint64_t value, std::uint64_t mask) noexcept
+        {
+            std::uint64_t result = 0;
+            for (std::uint64_t bit = 1; mask; bit <<= 1)
+            {
+                if (value & bit)
+                    result |= mask & (~mask + 1);
+                mask &= mask - 1;
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @breif Տ̍W̏W81rbgŕ\B
+     * @details position_to_position9x9 ŕϊ 0 ȏ 81 ̍Wrbg̈ʒuƂB
+     *          0 ȏ 64 ̍W m_low ɁA64 ȏ 81 ̍W m_high Ɋi[B
+     */
+    class bitboard_t
+    {
+    public:
+        using value_type = std::uint64_t;
+
+        constexpr static std::size_t low_size = 64;
+        constexpr static std::size_t size = file_size * rank_size;
+
+        /**
+         * @breif ̃rbg{[h\zB
+         */
+        constexpr inline bitboard_t() noexcept
+            : m_low{}
+            , m_high{}
+        {
+        }
+
+        /**
+         * @breif 64rbgƏ17rbgrbg{[h\zB
+         * @param low 64rbg
+         * @param high 17rbg
+         */
+        constexpr inline bitboard_t(value_type low, value_type high) noexcept
+            : m_low{ low }
+            , m_high{ high }
+        {
+        }
+
+        /**
+         * @breif Տ̑SĂ̍W܂ރrbg{[hԂB
+         * @return Տ̑SĂ̍W܂ރrbg{[h
+         */
+        constexpr inline static bitboard_t all() noexcept
+        {
+            return { ~value_type{}, (value_type{ 1 } << (size - low_size)) - 1 };
+        }
+
+        /**
+         * @breif 1̍Ŵ݂܂ރrbg{[hԂB
+         * @param position W
+         * @return 1̍Ŵ݂܂ރrbg{[h
+         */
+        constexpr inline static bitboard_t square(position_t position) noexcept
+        {
+            return square9x9(position_to_position9x9(position));
+        }
+
+        /**
+         * @breif 1̍Ŵ݂܂ރrbg{[hԂB
+         * @param position9x9 0 ȏ 81 ̍W
+         * @return 1̍Ŵ݂܂ރrbg{[h
+         */
+        constexpr inline static bitboard_t square9x9(position_t position9x9) noexcept
+        {
+            if (static_cast<std::size_t>(position9x9) < low_size)
+                return { value_type{ 1 } << position9x9, 0 };
+            return { 0, value_type{ 1 } << (position9x9 - low_size) };
+        }
+
+        constexpr inline value_type low() const noexcept { return m_low; }
+        constexpr inline value_type high() const noexcept { return m_high; }
+
+        constexpr inline bitboard_t operator ~() const noexcept { return bitboard_t{ ~m_low, ~m_high } & all(); }
+        constexpr inline bitboard_t operator &(const bitboard_t & bitboard) const noexcept { return { m_low & bitboard.m_low, m_high & bitboard.m_high }; }
+        constexpr inline bitboard_t operator |(const bitboard_t & bitboard) const noexcept { return { m_low | bitboard.m_low, m_high | bitboard.m_high }; }
+        constexpr inline bitboard_t operator ^(const bitboard_t & bitboard) const noexcept { return { m_low ^ bitboard.m_low, m_high ^ bitboard.m_high }; }
+        constexpr inline bitboard_t & operator &=(const bitboard_t & bitboard) noexcept { m_low &= bitboard.m_low; m_high &= bitboard.m_high; return *this; }
+        constexpr inline bitboard_t & operator |=(const bitboard_t & bitboard) noexcept { m_low |= bitboard.m_low; m_high |= bitboard.m_high; return *this; }
+        constexpr inline bitboard_t & operator ^=(const bitboard_t & bitboard) noexcept { m_low ^= bitboard.m_low; m_high ^= bitboard.m_high; return *this; }
+        constexpr inline bool operator ==(const bitboard_t & bitboard) const noexcept { return m_low == bitboard.m_low && m_high == bitboard.m_high; }
+        constexpr inline bool operator !=(const bitboard_t & bitboard) const noexcept { return !(*this == bitboard); }
+
+        /**
+         * @breif ł邩肷B
+         * @retval true ł
+         * @retval false łȂ
+         */
+        constexpr inline bool empty() const noexcept
+        {
+            return (m_low | m_high) == 0;
+        }
+
+        /**
+         * @breif W܂ނ肷B
+         * @param position W
+         * @retval true W܂
+         * @retval false W܂܂Ȃ
+         */
+        constexpr inline bool test(position_t position) const noexcept
+        {
+            return !(*this & square(position)).empty();
+        }
+
+        /**
+         * @breif WǉB
+         * @param position W
+         */
+        constexpr inline void set(position_t position) noexcept
+        {
+            *this |= square(position);
+        }
+
+        /**
+         * @breif W폜B
+         * @param position W
+         */
+        constexpr inline void reset(position_t position) noexcept
+        {
+            const bitboard_t bitboard = square(position);
+            m_low &= ~bitboard.m_low;
+            m_high &= ~bitboard.m_high;
+        }
+
+        /**
+         * @breif ܂܂W̐ԂB
+         * @return ܂܂W̐
+         */
+        inline std::size_t count() const noexcept
+        {
+            return details::population_count(m_low) + details::population_count(m_high);
+        }
+
+        /**
+         * @breif ܂܂Ŵŏ̍WԂB
+         * @return ŏ̍W
+         * @details ̃rbg{[hɑ΂Ă̊֐ĂяoꍇA`̓ƂȂB
+         */
+        inline position_t front() const noexcept
+        {
+            SHOGIPP_ASSERT(!empty());
+            if (m_low)
+                return position9x9_to_position(static_cast<position_t>(details::count_trailing_zeros(m_low)));
+            return position9x9_to_position(static_cast<position_t>(details::count_trailing_zeros(m_high) + low_size));
+        }
+
+        /**
+         * @breif ܂܂Ŵő̍WԂB
+         * @return ő̍W
+         * @details ̃rbg{[hɑ΂Ă̊֐ĂяoꍇA`̓ƂȂB
+         */
+        inline position_t back() const noexcept
+        {
+            SHOGIPP_ASSERT(!empty());
+            if (m_high)
+                return position9x9_to_position(static_cast<position_t>(details::bit_scan_reverse(m_high) + low_size));
+            return position9x9_to_position(static_cast<position_t>(details::bit_scan_reverse(m_low)));
+        }
+
+        /**
+         * @breif ܂܂Ŵŏ̍W폜ĕԂB
+         * @return ŏ̍W
+         * @details ̃rbg{[hɑ΂Ă̊֐ĂяoꍇA`̓ƂȂB
+         */
+        inline position_t pop() noexcept
+        {
+            return position9x9_to_position(pop9x9());
+        }
+
+        /**
+         * @breif ܂܂Ŵŏ̍W폜 0 ȏ 81 ̍WƂĕԂB
+         * @return ŏ̍W(0 ȏ 81 )
+         * @details ̃rbg{[hɑ΂Ă̊֐ĂяoꍇA`̓ƂȂB
+         */
+        inline position_t pop9x9() noexcept
+        {
+            SHOGIPP_ASSERT(!empty());
+            if (m_low)
+            {
+                const position_t position9x9 = static_cast<position_t>(details::count_trailing_zeros(m_low));
+                m_low &= m_low - 1;
+                return position9x9;
+            }
+            const position_t position9x9 = static_cast<position_t>(details::count_trailing_zeros(m_high) + low_size);
+            m_high &= m_high - 1;
+            return position9x9;
+        }
+
+        /**
+         * @breif ܂܂WɊ֐ɓnB
+         * @param function W󂯎֐(void(position_t))
+         */
+        template<typename Function>
+        inline void for_each(Function && function) const
+        {
+            bitboard_t temp{ *this };
+            while (!temp.empty())
+                function(temp.pop());
+        }
+
+    private:
+        value_type m_low;
+        value_type m_high;
+    };
+
 
     static const position_t default_king_pos_list[]
     {
@@ -1306,26 +1663,42 @@ namespace shogipp
     }
 
     /**
-     * @breif dȂnbVlԂB
-     * @return dȂnbVl
+     * @breif splitmix64 ɂ[
+     * @details ԂɊ̒萔ZASP˂ł֐ŝalԂB
+     *          Ԃ 2^64 ̌Ăяo܂ŏdȂ߁AԂl 2^64 ̌Ăяo܂ŏdȂB
      */
-    inline std::size_t unique_size_t_hash()
+    class splitmix64_t
     {
-        static std::minstd_rand rand{ SHOGIPP_SEED };
-        static std::uniform_int_distribution<std::size_t> uid{ std::numeric_limits<std::size_t>::min(), std::numeric_limits<std::size_t>::max() };
-        static std::unordered_set<std::size_t> returned;
+    public:
+        /**
+         * @breif [\zB
+         * @param seed 
+         */
+        constexpr explicit splitmix64_t(std::uint64_t seed) noexcept
+            : state{ seed }
+        {
+        }
 
-        std::size_t hash;
-        while (hash = uid(rand), returned.find(hash) != returned.end());
-        returned.insert(hash);
-        return hash;
-    }
+        /**
+         * @breif ̋[𐶐B
+         * @return [
+         */
+        constexpr std::uint64_t operator()() noexcept
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        }
 
-#ifdef SIZE_OF_HASH
+    private:
+        std::uint64_t state;
+    };
 
     /**
      * @breif Cӂ̃oCg̃nbVl񋟂B
      * @tparam HashSize nbVl̃oCg
+     * @details HashSize % sizeof(std::uint64_t) == 0 łȂ΂ȂȂB
      */
     template<std::size_t HashSize>
     class basic_hash_t
@@ -1336,29 +1709,18 @@ namespace shogipp
 
         constexpr static std::size_t hash_size = HashSize;
 
-        inline basic_hash_t() noexcept
+        constexpr inline basic_hash_t() noexcept
             : data{}
         {
         }
 
-        inline basic_hash_t(const basic_hash_t & hash) noexcept
-        {
-            std::copy(std::begin(hash.data), std::end(hash.data), std::begin(data));
-        }
-
-        inline basic_hash_t & operator =(const basic_hash_t & hash) noexcept
-        {
-            std::copy(std::begin(hash.data), std::end(hash.data), std::begin(data));
-            return *this;
-        }
+        constexpr inline basic_hash_t(const basic_hash_t & hash) noexcept = default;
+        constexpr inline basic_hash_t & operator =(const basic_hash_t & hash) noexcept = default;
 
         inline basic_hash_t & operator ^=(const basic_hash_t & hash) noexcept
         {
-            std::size_t * first = reinterpret_cast<std::size_t *>(data);
-            std::size_t * last = reinterpret_cast<std::size_t *>(data + hash_size);
-            const std::size_t * input = reinterpret_cast<const std::size_t *>(hash.data);
-            while (first != last)
-                *first++ ^= *input++;
+            for (std::size_t i = 0; i < word_size; ++i)
+                data[i] ^= hash.data[i];
             return *this;
         }
 
@@ -1379,36 +1741,65 @@ namespace shogipp
             return !std::equal(std::begin(data), std::end(data), std::begin(hash.data));
         }
 
+        /**
+         * @breif u\̓YvZ邽߂̃L[擾B
+         * @return L[
+         */
+        constexpr inline std::uint64_t key() const noexcept
+        {
+            return data[0];
+        }
+
+        /**
+         * @breif u\̃Gg؂邽߂̒l擾B
+         * @tparam Verification ؒľ^
+         * @return ؒl
+         * @details u\̓Y key() ̉ʃrbgvZ邽߁A
+         *          [h1Ȃꍇ͍ŏʃrbgAłȂꍇ2Ԗڂ̃[h猟ؒloB
+         */
+        template<typename Verification>
+        constexpr inline Verification verification() const noexcept
+        {
+            static_assert(std::is_unsigned_v<Verification>);
+            static_assert(sizeof(Verification) < sizeof(word_type));
+            constexpr int shift = std::numeric_limits<word_type>::digits - std::numeric_limits<Verification>::digits;
+            return static_cast<Verification>(data[word_size > 1 ? 1 : 0] >> shift);
+        }
+
         inline explicit operator std::size_t() const noexcept
         {
-            std::size_t hash = 0;
-            for (std::size_t i = 0; i < hash_size / sizeof(std::size_t); ++i)
-                hash ^= *reinterpret_cast<const std::size_t *>(data + i * sizeof(std::size_t));
-            return hash;
+            return static_cast<std::size_t>(key());
         }
 
         inline explicit operator std::string() const noexcept
         {
             std::ostringstream stream;
             stream << "0x";
-            for (std::size_t i = 0; i < hash_size / sizeof(std::size_t); ++i)
-                stream << std::hex << std::setfill('0') << std::setw(sizeof(size_t) * 2) << *reinterpret_cast<const std::size_t *>(data + i * sizeof(std::size_t));
+            for (std::size_t i = 0; i < word_size; ++i)
+                stream << std::hex << std::setfill('0') << std::setw(sizeof(word_type) * 2) << data[i];
             stream << std::flush;
             return stream.str();
         }
 
-        inline static basic_hash_t make_unique()
+        /**
+         * @breif [킩nbVl𐶐B
+         * @param generator [
+         * @return nbVl
+         */
+        template<typename Generator>
+        constexpr inline static basic_hash_t generate(Generator & generator) noexcept
         {
-            static_assert(hash_size % sizeof(std::size_t) == 0);
-            basic_hash_t unique;
-            for (std::size_t i = 0; i < hash_size / sizeof(std::size_t); ++i)
-                *reinterpret_cast<std::size_t *>(unique.data + i * sizeof(std::size_t)) = unique_size_t_hash();
-            return unique;
+            basic_hash_t hash;
+            for (std::size_t i = 0; i < word_size; ++i)
+                hash.data[i] = generator();
+            return hash;
         }
 
     private:
-        using byte_type = unsigned char;
-        byte_type data[hash_size]{};
+        using word_type = std::uint64_t;
+        static_assert(hash_size % sizeof(word_type) == 0);
+        constexpr static std::size_t word_size = hash_size / sizeof(word_type);
+        word_type data[word_size];
     };
 
     template<typename CharT, typename Traits, std::size_t HashSize>
@@ -1428,10 +1819,13 @@ namespace shogipp
         }
     };
 
-    using hash_t = basic_hash_t<SIZE_OF_HASH>;
-#else
-    using hash_t = std::size_t;
-#endif
+    /**
+     * @breif nbVl̃oCg
+     * @details u\̃Gg key()  verification() ŏƍ邽߁A64rbgŏ\łB
+     */
+    constexpr std::size_t default_hash_size = sizeof(std::uint64_t);
+
+    using hash_t = basic_hash_t<default_hash_size>;
 
     /**
      * @breif nbVl16i\̕ɕϊB
@@ -1440,13 +1834,7 @@ namespace shogipp
      */
     inline std::string hash_to_string(hash_t hash)
     {
-#ifdef SIZE_OF_HASH
         return static_cast<std::string>(hash);
-#else
-        std::ostringstream stream;
-        stream << "0x" << std::hex << std::setfill('0') << hash << std::flush;
-        return stream.str();
-#endif
     }
 
     constexpr std::size_t captured_pawn_size   = 9 * 2 + 1;
@@ -1502,14 +1890,18 @@ namespace shogipp
 
     /**
      * @breif nbVe[u
+     * @tparam Hash nbVľ^
      */
-    class hash_table_t
+    template<typename Hash>
+    class basic_hash_table_t
     {
     public:
+        using hash_type = Hash;
+
         /**
          * nbVe[u\zB
          */
-        inline hash_table_t();
+        constexpr inline basic_hash_table_t();
 
         /**
          * @breif Տ̋̃nbVlvZB
@@ -1517,7 +1909,7 @@ namespace shogipp
          * @param position ̍W
          * @return nbVl
          */
-        inline hash_t piece_hash(colored_piece_t piece, position_t position) const noexcept;
+        inline hash_type piece_hash(colored_piece_t piece, position_t position) const noexcept;
 
         /**
          * @breif ̃nbVlvZB
@@ -1526,48 +1918,45 @@ namespace shogipp
          * @param color 
          * @return nbVl
          */
-        inline hash_t captured_piece_hash(captured_piece_t piece, std::size_t count, color_t color) const noexcept;
+        inline hash_type captured_piece_hash(captured_piece_t piece, std::size_t count, color_t color) const noexcept;
 
         /**
          * @breif Ԃ̃nbVlvZB
          * @param color 
          * @return nbVl
          */
-        inline hash_t color_hash(color_t color) const noexcept;
-
-        /**
-         * @breif @̃nbVlvZB
-         * @param move @
-         * @param color 
-         * @return nbVl
-         */
-        inline hash_t move_hash(const move_t & move, color_t color) const noexcept;
+        inline hash_type color_hash(color_t color) const noexcept;
 
-        hash_t board_table[piece_size * file_size * rank_size];              // Ղ̃nbVe[u
-        hash_t captured_piece_table[captured_size * color_t::size()];            // ̃nbVe[u
-        hash_t color_table[color_t::size()];                                     // Ԃ̃nbVe[u
-        hash_t move_table[(position_size + 1) * position_size * color_t::size()];          // ړ̃nbVe[u
-        hash_t put_table[position_size * captured_piece_size * color_t::size()];      // ł̃nbVe[u
+        hash_type board_table[piece_size * file_size * rank_size];              // Ղ̃nbVe[u
+        hash_type captured_piece_table[captured_size * color_t::size()];            // ̃nbVe[u
+        hash_type color_table[color_t::size()];                                     // Ԃ̃nbVe[u
     };
 
-    static const hash_table_t hash_table;
-
-    inline hash_table_t::hash_table_t()
+    template<typename Hash>
+    constexpr inline basic_hash_table_t<Hash>::basic_hash_table_t()
+        : board_table{}
+        , captured_piece_table{}
+        , color_table{}
     {
-#ifdef SIZE_OF_HASH
-        auto generator = hash_t::make_unique;
-#else
-        auto generator = unique_size_t_hash;
-#endif
-
-        std::generate(std::begin(board_table         ), std::end(board_table         ), generator);
-        std::generate(std::begin(captured_piece_table), std::end(captured_piece_table), generator);
-        std::generate(std::begin(color_table         ), std::end(color_table         ), generator);
-        std::generate(std::begin(move_table          ), std::end(move_table          ), generator);
-        std::generate(std::begin(put_table           ), std::end(put_table           ), generator);
+        // 1 splitmix64_t SẴnbVl𐶐邽߁AenbVl̊e[h͏dȂB
+        splitmix64_t generator{ 0x5348'4F47'4950'5050 };
+        for (hash_type & hash : board_table)
+            hash = hash_type::generate(generator);
+        for (hash_type & hash : captured_piece_table)
+            hash = hash_type::generate(generator);
+        for (hash_type & hash : color_table)
+            hash = hash_type::generate(generator);
     }
 
-    inline hash_t hash_table_t::piece_hash(colored_piece_t piece, position_t position) const noexcept
+    using hash_table_t = basic_hash_table_t<hash_t>;
+
+    /**
+     * @breif RpCɐnbVe[u
+     */
+    static constexpr hash_table_t hash_table;
+
+    template<typename Hash>
+    inline typename basic_hash_table_t<Hash>::hash_type basic_hash_table_t<Hash>::piece_hash(colored_piece_t piece, position_t position) const noexcept
     {
         SHOGIPP_ASSERT(!piece.empty());
         std::size_t index = static_cast<std::size_t>(piece.value());
@@ -1579,7 +1968,8 @@ namespace shogipp
         return board_table[index];
     }
 
-    inline hash_t hash_table_t::captured_piece_hash(captured_piece_t piece, std::size_t count, color_t color) const noexcept
+    template<typename Hash>
+    inline typename basic_hash_table_t<Hash>::hash_type basic_hash_table_t<Hash>::captured_piece_hash(captured_piece_t piece, std::size_t count, color_t color) const noexcept
     {
         SHOGIPP_ASSERT(piece.value() >= pawn.value());
         SHOGIPP_ASSERT(piece.value() <= rook.value());
@@ -1599,7 +1989,8 @@ namespace shogipp
         return captured_piece_table[index];
     }
 
-    inline hash_t hash_table_t::color_hash(color_t color) const noexcept
+    template<typename Hash>
+    inline typename basic_hash_table_t<Hash>::hash_type basic_hash_table_t<Hash>::color_hash(color_t color) const noexcept
     {
         return color_table[color.value()];
     }
@@ -1710,11 +2101,13 @@ namespace shogipp
 
     /**
      * @breif @
+     * @details ړ̍WAړ̍WAړ̋Aړ̋A邩ۂA^O32rbg̐ɋl߂ĕێB
      */
     class move_t
     {
     public:
         using tag_t = unsigned char;
+        using value_type = std::uint32_t;
         enum : tag_t
         {
             none_tag    = 0x00,
@@ -1750,6 +2143,19 @@ namespace shogipp
          */
         inline move_t(std::string_view sfen_move, const board_t & board);
 
+        /**
+         * @breif 32rbg̐ɋl߂ꂽl\zB
+         * @param value value() Ŏ擾l
+         * @return 
+         */
+        constexpr static inline move_t from_value(value_type value) noexcept;
+
+        /**
+         * @breif 32rbg̐ɋl߂ꂽl擾B
+         * @return 32rbg̐ɋl߂ꂽl
+         */
+        constexpr inline value_type value() const noexcept;
+
         /**
          * @breif ł肩肷B
          * @retval true łł
@@ -1812,75 +2218,114 @@ namespace shogipp
          */
         inline tag_t tag() const noexcept;
 
+        /**
+         * @breif @肪ł邩肷B
+         * @param move @
+         * @retval true ł
+         * @retval false łȂ
+         * @details ^O͔rȂB
+         */
+        inline bool operator ==(const move_t & move) const noexcept;
+        inline bool operator !=(const move_t & move) const noexcept;
+
     private:
-        position_t      m_source;           // ړ̍W(source == npos ̏ꍇAł)
-        position_t      m_destination;      // ړ̍W(source == npos ̏ꍇA destination ͑łW)
-        colored_piece_t m_source_piece;     // ړ̋(source == npos ̏ꍇA source_piece() ͑ł)
-        colored_piece_t m_destination_piece;// ړ̋(source == npos ̏ꍇA captured_piece ͖`)
-        bool            m_promote;          // ꍇ true
-        tag_t           m_tag;              // ^O
+        constexpr static unsigned int source_shift              = 0;    // ړ̍W(7rbgAł̏ꍇ put_source)
+        constexpr static unsigned int destination_shift         = 7;    // ړ̍W(7rbg)
+        constexpr static unsigned int source_piece_shift        = 14;   // ړ̋邢͑ł(5rbg)
+        constexpr static unsigned int destination_piece_shift   = 19;   // ړ̋(5rbg)
+        constexpr static unsigned int promote_shift             = 24;   // 邩ۂ(1rbg)
+        constexpr static unsigned int tag_shift                 = 25;   // ^O(7rbg)
+        constexpr static value_type position_mask = 0x7F;
+        constexpr static value_type piece_mask    = 0x1F;
+        constexpr static value_type tag_mask      = 0x7F;
+        constexpr static value_type put_source    = position_mask;
+
+        /**
+         * @breif ̊evf32rbg̐ɋl߂B
+         */
+        constexpr static inline value_type encode(position_t source, position_t destination, piece_value_t source_piece, piece_value_t destination_piece, bool promote, tag_t tag) noexcept;
+
+        constexpr inline move_t() noexcept = default;
+
+        value_type m_value{};
     };
 
-    inline move_t::move_t(position_t destination, captured_piece_t captured_piece, tag_t tag) noexcept
-        : m_source{ npos }
-        , m_destination{ destination }
-        , m_source_piece{ captured_piece.value() }
-        , m_destination_piece{ empty.value() }
-        , m_promote{ false }
-        , m_tag{ tag }
+    static_assert(sizeof(move_t) == sizeof(move_t::value_type));
+
+    constexpr inline move_t::value_type move_t::encode(position_t source, position_t destination, piece_value_t source_piece, piece_value_t destination_piece, bool promote, tag_t tag) noexcept
     {
-        SHOGIPP_ASSERT(captured_piece.value() >= captured_pawn.value());
-        SHOGIPP_ASSERT(captured_piece.value() <= captured_rook.value());
+        static_assert(position_end <= put_source);
+        static_assert(piece_size <= piece_mask + 1);
+        return ((static_cast<value_type>(source) & position_mask) << source_shift)
+            | ((static_cast<value_type>(destination) & position_mask) << destination_shift)
+            | ((static_cast<value_type>(source_piece) & piece_mask) << source_piece_shift)
+            | ((static_cast<value_type>(destination_piece) & piece_mask) << destination_piece_shift)
+            | (static_cast<value_type>(promote) << promote_shift)
+            | ((static_cast<value_type>(tag) & tag_mask) << tag_shift);
     }
 
-    inline move_t::move_t(position_t source, position_t destination, colored_piece_t source_piece, colored_piece_t captured_piece, bool promote, tag_t tag) noexcept
-        : m_source{ source }
-        , m_destination{ destination }
-        , m_source_piece{ source_piece }
-        , m_destination_piece{ captured_piece }
-        , m_promote{ promote }
-        , m_tag{ tag }
+    constexpr inline move_t move_t::from_value(value_type value) noexcept
     {
+        move_t move;
+        move.m_value = value;
+        return move;
     }
 
-    inline bool move_t::put() const noexcept
+    constexpr inline move_t::value_type move_t::value() const noexcept
     {
-        return m_source == npos;
+        return m_value;
+    }
+
+    inline move_t::move_t(position_t destination, captured_piece_t captured_piece, tag_t tag) noexcept
+        : m_value{ encode(npos, destination, captured_piece.value(), empty.value(), false, tag) }
+    {
+        SHOGIPP_ASSERT(captured_piece.value() >= captured_pawn.value());
+        SHOGIPP_ASSERT(captured_piece.value() <= captured_rook.value());
+    }
+
+    inline move_t::move_t(position_t source, position_t destination, colored_piece_t source_piece, colored_piece_t captured_piece, bool promote, tag_t tag) noexcept
+        : m_value{ encode(source, destination, source_piece.value(), captured_piece.value(), promote, tag) }
+    {
+    }
+
+    inline bool move_t::put() const noexcept
+    {
+        return ((m_value >> source_shift) & position_mask) == put_source;
     }
 
     inline position_t move_t::source() const noexcept
     {
         SHOGIPP_ASSERT(!put());
-        return m_source;
+        return static_cast<position_t>((m_value >> source_shift) & position_mask);
     }
 
     inline position_t move_t::destination() const noexcept
     {
-        return m_destination;
+        return static_cast<position_t>((m_value >> destination_shift) & position_mask);
     }
 
     inline colored_piece_t move_t::source_piece() const noexcept
     {
         SHOGIPP_ASSERT(!put());
-        return m_source_piece;
+        return colored_piece_t{ static_cast<piece_value_t>((m_value >> source_piece_shift) & piece_mask) };
     }
 
     inline captured_piece_t move_t::captured_piece() const noexcept
     {
         SHOGIPP_ASSERT(put());
-        return captured_piece_t{ m_source_piece.value() };
+        return captured_piece_t{ static_cast<piece_value_t>((m_value >> source_piece_shift) & piece_mask) };
     }
 
     inline colored_piece_t move_t::destination_piece() const noexcept
     {
         SHOGIPP_ASSERT(!put());
-        return m_destination_piece;
+        return colored_piece_t{ static_cast<piece_value_t>((m_value >> destination_piece_shift) & piece_mask) };
     }
 
     inline bool move_t::promote() const noexcept
     {
         SHOGIPP_ASSERT(!put());
-        return m_promote;
+        return (m_value >> promote_shift) & 1;
     }
 
     inline std::string move_t::sfen_string() const
@@ -1888,8 +2333,7 @@ namespace shogipp
         std::string result;
         if (put())
         {
-            SHOGIPP_ASSERT(source_piece().to_color() == black);
-            const auto optional_piece = piece_to_sfen_string(source_piece());
+            const auto optional_piece = piece_to_sfen_string(colored_piece_t{ captured_piece().value() });
             SHOGIPP_ASSERT(optional_piece.has_value());
             SHOGIPP_ASSERT(optional_piece->size() == 1);
             result += *optional_piece;
@@ -1908,24 +2352,275 @@ namespace shogipp
 
     inline move_t::tag_t move_t::tag() const noexcept
     {
-        return m_tag;
+        return static_cast<tag_t>((m_value >> tag_shift) & tag_mask);
+    }
+
+    inline bool move_t::operator ==(const move_t & move) const noexcept
+    {
+        constexpr value_type mask = ~(tag_mask << tag_shift);
+        return (m_value & mask) == (move.m_value & mask);
+    }
+
+    inline bool move_t::operator !=(const move_t & move) const noexcept
+    {
+        return !(*this == move);
     }
 
     /**
-     * @breif @i[ std::vector \B
+     * @breif Œeʂ̉ϒz
+     * @tparam T vf̌^
+     * @tparam Capacity e
+     * @details vfIuWFNgɕێAImۂsȂBeʂ𒴂ėvfǉĂ͂ȂȂB
      */
-    class moves_t
-        : public std::vector<move_t>
+    template<typename T, std::size_t Capacity>
+    class fixed_vector_t
     {
     public:
-        using std::vector<move_t>::vector;
+        static_assert(std::is_trivially_destructible_v<T>);
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        constexpr static size_type capacity = Capacity;
+
+        inline fixed_vector_t() noexcept;
+        inline fixed_vector_t(const fixed_vector_t & other) noexcept(std::is_nothrow_copy_constructible_v<T>);
+        inline fixed_vector_t & operator =(const fixed_vector_t & other) noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+        inline pointer data() noexcept;
+        inline const_pointer data() const noexcept;
+        inline iterator begin() noexcept;
+        inline const_iterator begin() const noexcept;
+        inline const_iterator cbegin() const noexcept;
+        inline iterator end() noexcept;
+        inline const_iterator end() const noexcept;
+        inline const_iterator cend() const noexcept;
+        inline size_type size() const noexcept;
+        inline bool empty() const noexcept;
+        inline reference operator [](size_type index) noexcept;
+        inline const_reference operator [](size_type index) const noexcept;
+        inline reference front() noexcept;
+        inline const_reference front() const noexcept;
+        inline reference back() noexcept;
+        inline const_reference back() const noexcept;
+
+        /**
+         * @breif ɗvfǉB
+         * @param value vf
+         */
+        inline void push_back(const T & value) noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+        /**
+         * @breif ɗvf\zB
+         * @param args vf̃RXgN^
+         * @return \zꂽvf
+         */
+        template<typename ... Args>
+        inline reference emplace_back(Args && ... args) noexcept(std::is_nothrow_constructible_v<T, Args...>);
+
+        /**
+         * @breif ̗vf폜B
+         */
+        inline void pop_back() noexcept;
+
+        /**
+         * @breif SĂ̗vf폜B
+         */
+        inline void clear() noexcept;
+
+        /**
+         * @breif ͈̗͂vf폜B
+         * @param first 폜͈͂̐擪
+         * @param last 폜͈̖͂
+         * @return 폜ꂽ͈̗͂̒vfwCe[^
+         */
+        inline iterator erase(const_iterator first, const_iterator last);
+
+    private:
+        size_type m_size;
+        alignas(T) unsigned char m_storage[sizeof(T) * Capacity];
+    };
+
+    template<typename T, std::size_t Capacity>
+    inline fixed_vector_t<T, Capacity>::fixed_vector_t() noexcept
+        : m_size{ 0 }
+    {
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline fixed_vector_t<T, Capacity>::fixed_vector_t(const fixed_vector_t & other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : m_size{ 0 }
+    {
+        std::uninitialized_copy(other.begin(), other.end(), begin());
+        m_size = other.m_size;
+    }
 
-        inline moves_t()
+    template<typename T, std::size_t Capacity>
+    inline fixed_vector_t<T, Capacity> & fixed_vector_t<T, Capacity>::operator =(const fixed_vector_t & other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+        if (this != &other)
         {
-            constexpr std::size_t max_size = 593;
-            reserve(max_size);
+            m_size = 0;
+            std::uninitialized_copy(other.begin(), other.end(), begin());
+            m_size = other.m_size;
         }
-    };
+        return *this;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::pointer fixed_vector_t<T, Capacity>::data() noexcept
+    {
+        return std::launder(reinterpret_cast<T *>(m_storage));
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_pointer fixed_vector_t<T, Capacity>::data() const noexcept
+    {
+        return std::launder(reinterpret_cast<const T *>(m_storage));
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::iterator fixed_vector_t<T, Capacity>::begin() noexcept
+    {
+        return data();
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_iterator fixed_vector_t<T, Capacity>::begin() const noexcept
+    {
+        return data();
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_iterator fixed_vector_t<T, Capacity>::cbegin() const noexcept
+    {
+        return data();
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::iterator fixed_vector_t<T, Capacity>::end() noexcept
+    {
+        return data() + m_size;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_iterator fixed_vector_t<T, Capacity>::end() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_iterator fixed_vector_t<T, Capacity>::cend() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::size_type fixed_vector_t<T, Capacity>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline bool fixed_vector_t<T, Capacity>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::reference fixed_vector_t<T, Capacity>::operator [](size_type index) noexcept
+    {
+        SHOGIPP_ASSERT(index < m_size);
+        return data()[index];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_reference fixed_vector_t<T, Capacity>::operator [](size_type index) const noexcept
+    {
+        SHOGIPP_ASSERT(index < m_size);
+        return data()[index];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::reference fixed_vector_t<T, Capacity>::front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_reference fixed_vector_t<T, Capacity>::front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::reference fixed_vector_t<T, Capacity>::back() noexcept
+    {
+        return (*this)[m_size - 1];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::const_reference fixed_vector_t<T, Capacity>::back() const noexcept
+    {
+        return (*this)[m_size - 1];
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline void fixed_vector_t<T, Capacity>::push_back(const T & value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+        emplace_back(value);
+    }
+
+    template<typename T, std::size_t Capacity>
+    template<typename ... Args>
+    inline typename fixed_vector_t<T, Capacity>::reference fixed_vector_t<T, Capacity>::emplace_back(Args && ... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        SHOGIPP_ASSERT(m_size < Capacity);
+        T * const element = ::new (static_cast<void *>(m_storage + sizeof(T) * m_size)) T(std::forward<Args>(args)...);
+        ++m_size;
+        return *element;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline void fixed_vector_t<T, Capacity>::pop_back() noexcept
+    {
+        SHOGIPP_ASSERT(m_size > 0);
+        --m_size;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline void fixed_vector_t<T, Capacity>::clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    template<typename T, std::size_t Capacity>
+    inline typename fixed_vector_t<T, Capacity>::iterator fixed_vector_t<T, Capacity>::erase(const_iterator first, const_iterator last)
+    {
+        const iterator destination = begin() + (first - cbegin());
+        const iterator source = begin() + (last - cbegin());
+        const iterator new_end = std::move(source, end(), destination);
+        m_size = static_cast<size_type>(new_end - begin());
+        return destination;
+    }
+
+    /**
+     * @breif ǖʂɂ鍇@̍ő吔
+     */
+    constexpr std::size_t max_moves_size = 593;
+
+    /**
+     * @breif @̏W
+     * @details T̊eǖʂœImۂsȂ悤A@̍ő吔eʂƂŒeʂ̔zŕێB
+     */
+    using moves_t = fixed_vector_t<move_t, max_moves_size>;
 
     inline int to_category(const move_t & move) noexcept
     {
@@ -1944,28 +2639,6 @@ namespace shogipp
         return 0;
     };
 
-    inline hash_t hash_table_t::move_hash(const move_t & move, color_t color) const noexcept
-    {
-        std::size_t index;
-        if (move.put())
-        {
-            index = static_cast<std::size_t>(move.destination());
-            index *= captured_piece_size;
-            index += move.captured_piece().value();
-            index *= color_t::size();
-            index += color.value();
-            SHOGIPP_ASSERT(index < std::size(put_table));
-            return put_table[index];
-        }
-        index = static_cast<std::size_t>(move.source() - npos);
-        index *= position_size;
-        index += static_cast<std::size_t>(move.destination());
-        index *= color_t::size();
-        index += color.value();
-        SHOGIPP_ASSERT(index < std::size(move_table));
-        return move_table[index];
-    }
-
     /**
      * @breif 
      */
@@ -2221,101 +2894,624 @@ namespace shogipp
     }
 
     /**
-     * @breif ͂]B
+     * @breif ̔񔽕Iȗ̃rbg{[h̕\
      */
-    class enclosure_evaluator_t
+    class step_attack_table_t
     {
     public:
         /**
-         * @biref Ղ͂\zB
-         * @param board ̋܂ޔ
-         */
-        inline enclosure_evaluator_t(const std::string & name, const board_t & board);
-
-        /**
-         * @breif Ղƈ͂̋vZB
-         * @param board 
-         * @param color 
-         * @details color Ŏw肵ԈȊŐ͖B
+         * @breif ̔񔽕Iȗ̃rbg{[h̕\\zB
          */
-        inline evaluation_value_t distance(const board_t & board, color_t color) const;
+        inline step_attack_table_t();
 
         /**
-         * @breif ̖͂O擾B
-         * @return ̖͂O
+         * @breif ̔񔽕Iȗ̃rbg{[h擾B
+         * @param piece 
+         * @param position ̍W
+         * @return ̔񔽕Iȗ̃rbg{[h
          */
-        inline const std::string & name() const;
+        inline const bitboard_t & operator ()(colored_piece_t piece, position_t position) const noexcept;
 
     private:
-        class positions_t
+        bitboard_t m_table[piece_size][file_size * rank_size];
+    };
+
+    inline step_attack_table_t::step_attack_table_t()
+    {
+        for (const color_t color : colors)
         {
-        public:
-            constexpr static evaluation_value_t insufficient = std::numeric_limits<evaluation_value_t>::min();
+            for (piece_value_t piece = pawn_value; piece < noncolored_piece_size; ++piece)
+            {
+                const colored_piece_t colored_piece{ noncolored_piece_t{ piece }, color };
+                for (position_t position9x9 = 0; position9x9 < file_size * rank_size; ++position9x9)
+                {
+                    const position_t position = position9x9_to_position(position9x9);
+                    bitboard_t & bitboard = m_table[colored_piece.value()][position9x9];
+                    for (const position_t * offset = near_move_offsets(noncolored_piece_t{ piece }); *offset; ++offset)
+                    {
+                        const position_t destination = position + *offset * reverse(color);
+                        if (!board_t::out(destination))
+                            bitboard.set(destination);
+                    }
+                }
+            }
+        }
+    }
 
-            inline positions_t(const board_t & board);
-            inline evaluation_value_t distance(const positions_t & positions) const;
+    inline const bitboard_t & step_attack_table_t::operator ()(colored_piece_t piece, position_t position) const noexcept
+    {
+        SHOGIPP_ASSERT(!piece.empty());
+        SHOGIPP_ASSERT(piece.value() < piece_size);
+        return m_table[piece.value()][position_to_position9x9(position)];
+    }
 
-            position_t pawn_destination[file_size];
-            position_t lance_destination[2];
-            position_t knight_destination[2];
-            position_t silver_destination[2];
-            position_t gold_destination[2];
-            position_t bishop_destination;
-            position_t king_destination;
+    static const step_attack_table_t step_attack_table;
+
+    /**
+     * @breif ы̗̃rbg{[h̕\
+     * @details cAA2̎΂߂̒ƂɁA̋̔zu痘x̕\ŋ߂B
+     *          ̒[ƋgW̐L󋵂A SHOGIPP_USE_BMI2 `Ăꍇ PEXT ŁA
+     *          `ĂȂꍇ magic bitboard ̏Zŋl߂čƂB
+     */
+    class sliding_attack_table_t
+    {
+    public:
+        /**
+         * @breif ̎
+         */
+        enum line_t
+        {
+            file_line,          // c
+            rank_line,          // 
+            diagonal_line,      // ォEւ̎΂
+            antidiagonal_line,  // Eォ獶ւ̎΂
+            line_size
         };
 
-        std::string m_name;
-        positions_t m_positions;
-    };
+        constexpr static std::size_t direction_size = line_size * 2;
+        constexpr static std::size_t max_line_occupancy_size = 1 << (file_size - 2);
 
-    inline enclosure_evaluator_t::positions_t::positions_t(const board_t & board)
-    {
-        std::fill(std::begin(pawn_destination), std::end(pawn_destination), npos);
-        std::fill(std::begin(lance_destination), std::end(lance_destination), npos);
-        std::fill(std::begin(knight_destination), std::end(knight_destination), npos);
-        std::fill(std::begin(silver_destination), std::end(silver_destination), npos);
-        std::fill(std::begin(gold_destination), std::end(gold_destination), npos);
-        bishop_destination = npos;
-        king_destination = npos;
+        /**
+         * @breif ы̗̃rbg{[h̕\\zB
+         */
+        inline sliding_attack_table_t();
 
-        std::map<colored_piece_t, std::vector<position_t>> map;
-        for (piece_value_t piece = pawn_value; piece <= king_value; ++piece)
-            for (position_t position = position_begin; position != position_end; ++position)
-                if (!board_t::out(position) && board[position] == colored_piece_t{ piece })
-                    map[piece].push_back(position);
+        /**
+         * @breif ̑΍W̓Y擾B
+         * @param offset ̑΍W
+         * @return ̓Y
+         */
+        inline static std::size_t direction_index(position_t offset) noexcept;
 
-        if (map[black_king].size() != 1)
-            throw invalid_enclosure{ "map[black_king].size() != 1" };
-        king_destination = map[black_king][0];
+        /**
+         * @breif W瑊΍W offset ̔Ղ̒[܂ł̍W̃rbg{[h擾B
+         * @param position W
+         * @param offset ̑΍W
+         * @return W̃rbg{[h(position ܂܂Ȃ)
+         */
+        inline const bitboard_t & ray(position_t position, position_t offset) const noexcept;
 
-        // ̋̈ړ悩E̋̈ړ̏ɕёւB
-        const auto comparator = [](position_t position1, position_t position2) -> bool
+        /**
+         * @breif ̗̃rbg{[h擾B
+         * @param line ̎
+         * @param position ̍W
+         * @param occupancy Տ̑SĂ̋̍W̃rbg{[h
+         * @return ̗̃rbg{[h
+         */
+        inline const bitboard_t & line_attacks(line_t line, position_t position, const bitboard_t & occupancy) const noexcept;
+
+        /**
+         * @breif ΍W offset ̗̃rbg{[h擾B
+         * @param position ̍W
+         * @param offset ̑΍W
+         * @param occupancy Տ̑SĂ̋̍W̃rbg{[h
+         * @return ̃rbg{[h(ŏɌ̍W܂)
+         */
+        inline bitboard_t ray_attacks(position_t position, position_t offset, const bitboard_t & occupancy) const noexcept;
+
+        /**
+         * @breif ̔Iȗ̃rbg{[h擾B
+         * @param piece 
+         * @param position ̍W
+         * @param occupancy Տ̑SĂ̋̍W̃rbg{[h
+         * @return ̔Iȗ̃rbg{[h(ыłȂꍇÃrbg{[h)
+         */
+        inline bitboard_t operator ()(colored_piece_t piece, position_t position, const bitboard_t & occupancy) const noexcept;
+
+    private:
+        /**
+         * @breif ̋̔zu\̓YvZB
+         * @param line ̎
+         * @param position9x9 0 ȏ 81 ̋̍W
+         * @param occupancy Տ̑SĂ̋̍W̃rbg{[h
+         * @return \̓Y
+         */
+        inline std::size_t index(std::size_t line, position_t position9x9, const bitboard_t & occupancy) const noexcept;
+
+        constexpr static position_t directions[direction_size]
         {
-            const position_t file1 = position_to_file(position1);
-            const position_t file2 = position_to_file(position2);
-            if (file1 < file2)
-                return true;
-            if (file1 > file2)
-                return false;
-            const position_t rank1 = position_to_rank(position1);
-            const position_t rank2 = position_to_rank(position2);
-            if (file1 <= file_size / 2)
-                return (rank1 < rank2);
-            return (rank1 > rank2);
+            front, back, left, right, front_left, back_right, front_right, back_left
         };
-        for (auto & [colored_piece, positions] : map)
-            std::sort(positions.begin(), positions.end(), comparator);
 
-        const auto is_left_side = [](position_t position) -> bool
+#ifndef SHOGIPP_USE_BMI2
+        /**
+         * @breif ̎ނ 0 ȏ 81 ̋̍WƂ magic number
+         * @details ̋̑SĂ̔zuɂāAقȂzuYɏՓ˂ȂƂmFς݂̒lłB
+         *          NɒTȂ悤A\ߒTl𖄂ߍށB
+         */
+        constexpr static std::uint64_t magics[line_size][file_size * rank_size]
+        {
+        {
+            0x8084908202006501, 0x202001040080080A, 0x7800880200894019,
+            0x1011518021002041, 0x008101A080920820, 0x0200100409401002,
+            0x8062100228200404, 0x0008100408080044, 0x0220022684080245,
+            0x0000584711420241, 0x1001900040408080, 0x4015808188808004,
+            0x0210082541808010, 0x1000250041080244, 0x0088000820081010,
+            0x83441C2002105628, 0xAE02180464008C01, 0x4114001062020022,
+            0x00040184011A0095, 0xC0A6810100208100, 0x0402001100188180,
+            0x2002000051800808, 0x1020200060204C10, 0x0400804008020410,
+            0x120051041901100A, 0x0025500020099202, 0x0020030008020242,
+            0x2018022081430301, 0x4002222404005041, 0x08210210420008C0,
+            0x1004810001001042, 0x1204628200414002, 0x0800480844140808,
+            0x4082102000101098, 0x4101111A04210801, 0x002022280440820A,
+            0x4864040C00020011, 0xE024084808401010, 0x3450040902142005,
+            0x0B08840100011010, 0x1A00483080085020, 0x9121000820102230,
+            0x0021915120200408, 0x1A02301022002862, 0x0220440800808A02,
+            0x0010410803811041, 0x04208C0080840080, 0x0290121841000030,
+            0x0804008061000002, 0x4302019860A10020, 0x0061012180842104,
+            0x0045001010852014, 0x0280428401021004, 0x10840A0204010022,
+            0x400C2802004A0201, 0x205A104404801040, 0x18041050C3010008,
+            0x50080100A0081010, 0xA402420120401B42, 0x0841898080040410,
+            0x0111001004100080, 0x4011884008280110, 0x0809208850028881,
+            0x4810052204004201, 0x21827002002300A0, 0x0028024080204080,
+            0x010080808100A420, 0x1002484080144008, 0x044080A008400908,
+            0x0008181004101032, 0x000A800848C10042, 0x408A20A21200510A,
+            0x004A100220210021, 0x8010040840302421, 0x400404148020A822,
+            0x410200C100053040, 0x1800481104201820, 0x0400800404288210,
+            0x0082045410104108, 0x05E0041828101022, 0x45C0440088084286,
+        },
         {
-            return position_to_file(position) <= file_size / 2;
+            0x408081480080002A, 0x0100010402242280, 0x40808A0802000212,
+            0x2040020000001400, 0x8900200A040800A2, 0x08110000A28200B0,
+            0x0408002000000400, 0x0200300400000084, 0x2100000400003000,
+            0x0000808008000000, 0x0504800001040308, 0x0009802004088000,
+            0x0A10202010000007, 0x0288102080005060, 0x0488800010100012,
+            0x0010800800088108, 0x400100080404C104, 0x8800800900860841,
+            0x010940C00004004C, 0x0004182068800014, 0x080040C000020008,
+            0x0080014000000000, 0x00001C0840610000, 0x00318A0400000100,
+            0x4400290200001009, 0x0000104006008206, 0x1704044001001030,
+            0x0010014244400000, 0x0048010820000100, 0x0014001810040004,
+            0x0812220408200020, 0x4040034120404001, 0x1928500102144408,
+            0x9102224081088420, 0x4520204504058000, 0x0122120020000008,
+            0x4400004000300020, 0x0444800280100820, 0x10200080903000A0,
+            0x0044006111500085, 0x0000888A41020000, 0x0000880005100210,
+            0x05080000004090E2, 0x08008B7B08600400, 0x654200A004810004,
+            0x0C02100088010800, 0x8140080801181040, 0x3800044401241802,
+            0x0000880400410200, 0x0081A01400004800, 0x8005000020008804,
+            0x000000000100A040, 0x0000441110001000, 0x0040040140050200,
+            0x00309B002000349C, 0x8240410100002004, 0x040800022000042C,
+            0x0880C00000010314, 0x410000C001022024, 0x0000901003400444,
+            0x0010A08040411084, 0x9000010112005008, 0x0104080404000204,
+            0x0200110000108400, 0x041014082208A400, 0x1600251280081800,
+            0x0A00020200000200, 0x1202011010320000, 0x1020000000080210,
+            0x4200060008600042, 0x5404000422000021, 0x0200000000002089,
+            0x0007000629480002, 0xA081040080302081, 0x100B000928040015,
+            0x8020408424000000, 0x0010201107000241, 0x00181080840A20C0,
+            0x2A2C0910008A0000, 0x0C20801004200000, 0x0042040180200005,
+        },
+        {
+            0x1108011110400208, 0x1002006014201001, 0x00041028E0200906,
+            0xC022090088654010, 0x0007052C20100000, 0x000B805500800420,
+            0x0004800000000208, 0x0001500100001004, 0x0001000168008804,
+            0x040000828380041C, 0x8021040083100108, 0x5040008088404109,
+            0x0802810221210100, 0x802000D2400830C0, 0x2A0040CC21400004,
+            0x0248044000804140, 0x00200013200C8000, 0x4000840080000010,
+            0x0200080104244020, 0x0080809100808C10, 0x0020020012400C42,
+            0x0001868442600204, 0x0108240020900102, 0x0501021060500C00,
+            0x00AA802010060260, 0x2005420020802010, 0x8A08802054040408,
+            0x1280142012004041, 0x1260010001008104, 0x0860106100400808,
+            0x00A0450009443006, 0x240C028040049002, 0x1001292000200625,
+            0x242A006001100400, 0x6116A8C002104002, 0x1012A14C90420000,
+            0x2220008044010064, 0x444000A002008440, 0x01200C04000020A0,
+            0x0192048A00804001, 0x0020026100000402, 0x4A562140C2001002,
+            0x020C004020200800, 0x00C4005020020008, 0x3022202013003102,
+            0x2009400010498108, 0x180000A001830182, 0x04008130A4000024,
+            0x0100200222010610, 0x4280280449000004, 0x0090408042200808,
+            0x5601008080402101, 0x0012010010200400, 0x2403091020422530,
+            0xB008010000425000, 0x420000410080C000, 0x2020012000210008,
+            0x3008000521858028, 0x0400002612215120, 0x1210028101004404,
+            0x0010050200201280, 0x0001210480401A00, 0x08410080C0A01080,
+            0x421C010000100104, 0x0000200130200808, 0x0000000200200109,
+            0x0000000000420142, 0xA00C000085008040, 0x0200000211101022,
+            0x0010030101001808, 0x888624047A202001, 0x008914214088080C,
+            0x0280020004400810, 0x2032410200008448, 0xA231000120200011,
+            0x2002000080663100, 0x2500408000E09840, 0x080000001400C008,
+            0x8E00018402019002, 0x0100060600084001, 0x0020452840241002,
+        },
+        {
+            0x0000000108080480, 0x0010000050C00400, 0x82200500002C0402,
+            0x102C508002121480, 0x0006080401020085, 0x4801020A84024000,
+            0x0442010088502000, 0x280080C101482012, 0x8402284011802002,
+            0x0000410040100520, 0x0210500010000008, 0x000010013000240A,
+            0x9060860984200000, 0x0080840241002000, 0x0800008E01004003,
+            0x0201041080610840, 0x3000002080084005, 0x1000000402404820,
+            0x4E3040084502E102, 0x01300000008140C0, 0x0059040500420002,
+            0x0004004102110010, 0x04410000A2005000, 0x0011001840245080,
+            0x1100400080440920, 0x2130080048143042, 0x7040080A08022184,
+            0x0068104002C20105, 0x0008044010080001, 0x0821140002008250,
+            0x0280420002811000, 0x000E822010450050, 0x94141B8004302040,
+            0x200009404410140A, 0x6040000008CC1810, 0x09010020014C10E2,
+            0x402E050804054000, 0x01040A4900001009, 0x8001048200004140,
+            0x3000402900049080, 0x101814088000C020, 0x0805008441405020,
+            0x0400200488181020, 0x0808018000001205, 0x0208006404008408,
+            0x1011109402281440, 0x4021810221500910, 0x0020810440100020,
+            0x8002141020404808, 0x2009000812050040, 0x200040C10C10300A,
+            0x1102800224080125, 0x0E01081104108418, 0x0C80840200900012,
+            0x004100842A024830, 0x0008208110470500, 0x1000204108048000,
+            0x4003007004082000, 0x1240002020280404, 0x1128000200194400,
+            0x0402044000000A00, 0x0601008400008000, 0x0240000810008000,
+            0x0001081120810040, 0x0302041040600880, 0xA028164841101420,
+            0x82A0000012082044, 0x000810C000281284, 0x0008100020040804,
+            0x0000180040020844, 0x8001000000000060, 0x8C80020068010014,
+            0x1002208004401892, 0x0400200220400810, 0x0402046106481020,
+            0x1043010480082586, 0x2500020008080802, 0x0421400325000002,
+            0x030F210001014230, 0x0000000000080018, 0x0220000020000508,
+        },
         };
+#endif
+
+        bitboard_t m_rays[direction_size][file_size * rank_size];
+        bitboard_t m_masks[line_size][file_size * rank_size];
+        unsigned char m_shifts[line_size][file_size * rank_size]{};
+        bitboard_t m_attacks[line_size][file_size * rank_size][max_line_occupancy_size];
+    };
 
+    inline sliding_attack_table_t::sliding_attack_table_t()
+    {
+        for (position_t position9x9 = 0; position9x9 < file_size * rank_size; ++position9x9)
         {
-            const std::vector<position_t> & pawn_positions = map[black_pawn];
-            if (pawn_positions.size() > std::size(pawn_destination))
-                throw invalid_enclosure{ "pawn_positions.size() > std::size(pawn_destination)" };
-            for (std::size_t i = 0; i < pawn_positions.size(); ++i)
+            const position_t position = position9x9_to_position(position9x9);
+
+            for (std::size_t direction = 0; direction < direction_size; ++direction)
+                for (position_t current = position + directions[direction]; !board_t::out(current); current += directions[direction])
+                    m_rays[direction][position9x9].set(current);
+
+            for (std::size_t line = 0; line < line_size; ++line)
+            {
+                // ̒[̍ẂA̐ɋ݂ȂߗɉeȂB
+                bitboard_t & mask = m_masks[line][position9x9];
+                for (const std::size_t direction : { line * 2, line * 2 + 1 })
+                    for (position_t current = position + directions[direction]; !board_t::out(current + directions[direction]); current += directions[direction])
+                        mask.set(current);
+
+                const std::size_t mask_size = mask.count();
+                const std::size_t occupancy_size = std::size_t{ 1 } << mask_size;
+                SHOGIPP_ASSERT(occupancy_size <= max_line_occupancy_size);
+                bitboard_t occupancy_list[max_line_occupancy_size];
+                bitboard_t attacks_list[max_line_occupancy_size];
+                for (std::size_t i = 0; i < occupancy_size; ++i)
+                {
+                    const std::size_t low_size = details::population_count(mask.low());
+                    occupancy_list[i] = bitboard_t
+                    {
+                        details::parallel_bits_deposit(i, mask.low()),
+                        details::parallel_bits_deposit(i >> low_size, mask.high())
+                    };
+                    for (const std::size_t direction : { line * 2, line * 2 + 1 })
+                    {
+                        for (position_t current = position + directions[direction]; !board_t::out(current); current += directions[direction])
+                        {
+                            attacks_list[i].set(current);
+                            if (occupancy_list[i].test(current))
+                                break;
+                        }
+                    }
+                }
+
+#ifdef SHOGIPP_USE_BMI2
+                m_shifts[line][position9x9] = static_cast<unsigned char>(details::population_count(mask.low()));
+#else
+                // ̍W͉64rbgƏ17rbgŏdȂȂ߁A_a164rbgɂ܂Ƃ߂B
+                SHOGIPP_ASSERT((mask.low() & mask.high()) == 0);
+                m_shifts[line][position9x9] = static_cast<unsigned char>(mask_size ? 64 - mask_size : 63);
+#endif
+                for (std::size_t i = 0; i < occupancy_size; ++i)
+                {
+                    bitboard_t & attacks = m_attacks[line][position9x9][index(line, position9x9, occupancy_list[i])];
+                    SHOGIPP_ASSERT(attacks.empty() || attacks == attacks_list[i]);
+                    attacks = attacks_list[i];
+                }
+            }
+        }
+    }
+
+    inline std::size_t sliding_attack_table_t::index(std::size_t line, position_t position9x9, const bitboard_t & occupancy) const noexcept
+    {
+        const bitboard_t & mask = m_masks[line][position9x9];
+#ifdef SHOGIPP_USE_BMI2
+        return static_cast<std::size_t>(_pext_u64(occupancy.low(), mask.low())
+            | (_pext_u64(occupancy.high(), mask.high()) << m_shifts[line][position9x9]));
+#else
+        const std::uint64_t merged = (occupancy.low() & mask.low()) | (occupancy.high() & mask.high());
+        return static_cast<std::size_t>((merged * magics[line][position9x9]) >> m_shifts[line][position9x9]);
+#endif
+    }
+
+    inline std::size_t sliding_attack_table_t::direction_index(position_t offset) noexcept
+    {
+        switch (offset)
+        {
+        case front      : return 0;
+        case back       : return 1;
+        case left       : return 2;
+        case right      : return 3;
+        case front_left : return 4;
+        case back_right : return 5;
+        case front_right: return 6;
+        case back_left  : return 7;
+        }
+        SHOGIPP_ASSERT(false);
+        return 0;
+    }
+
+    inline const bitboard_t & sliding_attack_table_t::ray(position_t position, position_t offset) const noexcept
+    {
+        return m_rays[direction_index(offset)][position_to_position9x9(position)];
+    }
+
+    inline const bitboard_t & sliding_attack_table_t::line_attacks(line_t line, position_t position, const bitboard_t & occupancy) const noexcept
+    {
+        const position_t position9x9 = position_to_position9x9(position);
+        return m_attacks[line][position9x9][index(line, position9x9, occupancy)];
+    }
+
+    inline bitboard_t sliding_attack_table_t::ray_attacks(position_t position, position_t offset, const bitboard_t & occupancy) const noexcept
+    {
+        const std::size_t direction = direction_index(offset);
+        return line_attacks(static_cast<line_t>(direction / 2), position, occupancy) & m_rays[direction][position_to_position9x9(position)];
+    }
+
+    inline bitboard_t sliding_attack_table_t::operator ()(colored_piece_t piece, position_t position, const bitboard_t & occupancy) const noexcept
+    {
+        SHOGIPP_ASSERT(!piece.empty());
+        switch (noncolored_piece_t{ piece }.value())
+        {
+        case lance_value:
+            return ray_attacks(position, front * reverse(piece.to_color()), occupancy);
+        case bishop_value:
+        case promoted_bishop_value:
+            return line_attacks(diagonal_line, position, occupancy) | line_attacks(antidiagonal_line, position, occupancy);
+        case rook_value:
+        case promoted_rook_value:
+            return line_attacks(file_line, position, occupancy) | line_attacks(rank_line, position, occupancy);
+        }
+        return {};
+    }
+
+    static const sliding_attack_table_t sliding_attack_table;
+
+    /**
+     * @breif 2̍W̊Ԃ̍W̃rbg{[h̕\
+     */
+    class between_table_t
+    {
+    public:
+        /**
+         * @breif 2̍W̊Ԃ̍W̃rbg{[h̕\\zB
+         */
+        inline between_table_t();
+
+        /**
+         * @breif 2̍W̊Ԃ̍W̃rbg{[h擾B
+         * @param a W
+         * @param b W
+         * @return a  b cAA΂߂̂ꂩ̒ɂꍇA a  b ̊Ԃ̍W̃rbg{[h(a  b ܂܂Ȃ)B
+         *         ȊȌꍇÃrbg{[h
+         */
+        inline const bitboard_t & operator ()(position_t a, position_t b) const noexcept;
+
+    private:
+        bitboard_t m_table[file_size * rank_size][file_size * rank_size];
+    };
+
+    inline between_table_t::between_table_t()
+    {
+        static constexpr position_t offsets[]
+        {
+            front, back, left, right, front_left, back_right, front_right, back_left
+        };
+
+        for (position_t a9x9 = 0; a9x9 < file_size * rank_size; ++a9x9)
+        {
+            const position_t a = position9x9_to_position(a9x9);
+            for (const position_t offset : offsets)
+            {
+                bitboard_t between;
+                for (position_t b = a + offset; !board_t::out(b); b += offset)
+                {
+                    m_table[a9x9][position_to_position9x9(b)] = between;
+                    between.set(b);
+                }
+            }
+        }
+    }
+
+    inline const bitboard_t & between_table_t::operator ()(position_t a, position_t b) const noexcept
+    {
+        return m_table[position_to_position9x9(a)][position_to_position9x9(b)];
+    }
+
+    static const between_table_t between_table;
+
+    /**
+     * @breif ؂̍W̃rbg{[h̕\
+     */
+    class file_table_t
+    {
+    public:
+        /**
+         * @breif ؂̍W̃rbg{[h̕\\zB
+         */
+        inline file_table_t();
+
+        /**
+         * @breif ؂̍W̃rbg{[h擾B
+         * @param file 
+         * @return ؂̍W̃rbg{[h
+         */
+        inline const bitboard_t & operator ()(position_t file) const noexcept;
+
+    private:
+        bitboard_t m_table[file_size];
+    };
+
+    inline file_table_t::file_table_t()
+    {
+        for (position_t file = 0; file < file_size; ++file)
+            for (position_t rank = 0; rank < rank_size; ++rank)
+                m_table[file].set(file_rank_to_position(file, rank));
+    }
+
+    inline const bitboard_t & file_table_t::operator ()(position_t file) const noexcept
+    {
+        SHOGIPP_ASSERT(file >= 0 && file < file_size);
+        return m_table[file];
+    }
+
+    static const file_table_t file_table;
+
+    /**
+     * @breif ̗̃rbg{[h擾B
+     * @param piece 
+     * @param position ̍W
+     * @param occupancy Տ̑SĂ̋̍W̃rbg{[h
+     * @return ̗̃rbg{[h
+     */
+    inline bitboard_t piece_attacks(colored_piece_t piece, position_t position, const bitboard_t & occupancy) noexcept
+    {
+        return step_attack_table(piece, position) | sliding_attack_table(piece, position, occupancy);
+    }
+
+    /**
+     * @breif ΍W offset ɔIɗ肷B
+     * @param piece 
+     * @param offset ̑΍W
+     * @retval true Iɗ
+     * @retval false IɗȂ
+     */
+    inline bool is_sliding(colored_piece_t piece, position_t offset) noexcept
+    {
+        SHOGIPP_ASSERT(!piece.empty());
+        switch (noncolored_piece_t{ piece }.value())
+        {
+        case lance_value:
+            return offset == front * reverse(piece.to_color());
+        case bishop_value:
+        case promoted_bishop_value:
+            return offset == front_left || offset == front_right || offset == back_left || offset == back_right;
+        case rook_value:
+        case promoted_rook_value:
+            return offset == front || offset == left || offset == right || offset == back;
+        }
+        return false;
+    }
+
+    /**
+     * @breif ͂]B
+     */
+    class enclosure_evaluator_t
+    {
+    public:
+        /**
+         * @biref Ղ͂\zB
+         * @param board ̋܂ޔ
+         */
+        inline enclosure_evaluator_t(const std::string & name, const board_t & board);
+
+        /**
+         * @breif Ղƈ͂̋vZB
+         * @param board 
+         * @param color 
+         * @details color Ŏw肵ԈȊŐ͖B
+         */
+        inline evaluation_value_t distance(const board_t & board, color_t color) const;
+
+        /**
+         * @breif ̖͂O擾B
+         * @return ̖͂O
+         */
+        inline const std::string & name() const;
+
+    private:
+        class positions_t
+        {
+        public:
+            constexpr static evaluation_value_t insufficient = std::numeric_limits<evaluation_value_t>::min();
+
+            inline positions_t(const board_t & board);
+            inline evaluation_value_t distance(const positions_t & positions) const;
+
+            position_t pawn_destination[file_size];
+            position_t lance_destination[2];
+            position_t knight_destination[2];
+            position_t silver_destination[2];
+            position_t gold_destination[2];
+            position_t bishop_destination;
+            position_t king_destination;
+        };
+
+        std::string m_name;
+        positions_t m_positions;
+    };
+
+    inline enclosure_evaluator_t::positions_t::positions_t(const board_t & board)
+    {
+        std::fill(std::begin(pawn_destination), std::end(pawn_destination), npos);
+        std::fill(std::begin(lance_destination), std::end(lance_destination), npos);
+        std::fill(std::begin(knight_destination), std::end(knight_destination), npos);
+        std::fill(std::begin(silver_destination), std::end(silver_destination), npos);
+        std::fill(std::begin(gold_destination), std::end(gold_destination), npos);
+        bishop_destination = npos;
+        king_destination = npos;
+
+        std::map<colored_piece_t, std::vector<position_t>> map;
+        for (piece_value_t piece = pawn_value; piece <= king_value; ++piece)
+            for (position_t position = position_begin; position != position_end; ++position)
+                if (!board_t::out(position) && board[position] == colored_piece_t{ piece })
+                    map[piece].push_back(position);
+
+        if (map[black_king].size() != 1)
+            throw invalid_enclosure{ "map[black_king].size() != 1" };
+        king_destination = map[black_king][0];
+
+        // ̋̈ړ悩E̋̈ړ̏ɕёւB
+        const auto comparator = [](position_t position1, position_t position2) -> bool
+        {
+            const position_t file1 = position_to_file(position1);
+            const position_t file2 = position_to_file(position2);
+            if (file1 < file2)
+                return true;
+            if (file1 > file2)
+                return false;
+            const position_t rank1 = position_to_rank(position1);
+            const position_t rank2 = position_to_rank(position2);
+            if (file1 <= file_size / 2)
+                return (rank1 < rank2);
+            return (rank1 > rank2);
+        };
+        for (auto & [colored_piece, positions] : map)
+            std::sort(positions.begin(), positions.end(), comparator);
+
+        const auto is_left_side = [](position_t position) -> bool
+        {
+            return position_to_file(position) <= file_size / 2;
+        };
+
+        {
+            const std::vector<position_t> & pawn_positions = map[black_pawn];
+            if (pawn_positions.size() > std::size(pawn_destination))
+                throw invalid_enclosure{ "pawn_positions.size() > std::size(pawn_destination)" };
+            for (std::size_t i = 0; i < pawn_positions.size(); ++i)
                 pawn_destination[position_to_file(pawn_positions[i])] = pawn_positions[i];
         }
 
@@ -3308,7 +4504,6 @@ namespace shogipp
     }
 
     inline move_t::move_t(std::string_view sfen_move, const board_t & board)
-        : m_tag{ none_tag }
     {
         if (sfen_move.size() < 4)
             throw invalid_usi_input{ "invalid sfen move" };
@@ -3324,11 +4519,7 @@ namespace shogipp
                 throw invalid_usi_input{ "invalid sfen move" };
             const position_t destination = sfen_position_to_position(sfen_move.substr(2, 2));
 
-            m_source = npos;
-            m_destination = destination;
-            m_source_piece = *optional_piece;
-            m_destination_piece = colored_piece_t{};
-            m_promote = false;
+            m_value = encode(npos, destination, optional_piece->value(), empty.value(), false, none_tag);
         }
         else
         {
@@ -3348,11 +4539,7 @@ namespace shogipp
             else
                 throw invalid_usi_input{ "invalid sfen move" };
 
-            m_source = source;
-            m_destination = destination;
-            m_source_piece = board[source];
-            m_destination_piece = board[destination];
-            m_promote = promote;
+            m_value = encode(source, destination, board[source].value(), board[destination].value(), promote, none_tag);
         }
     }
 
@@ -3367,17 +4554,76 @@ namespace shogipp
         bool aigoma;            // \
     };
 
+    /**
+     * @breif ɓɗ̍ő吔
+     * @details @ȋǖʂŉɓɗ͗̏ꍇ2őłB
+     */
+    constexpr std::size_t max_check_size = 2;
+
+    /**
+     * @breif ԂɂĂ鉤̏W
+     */
+    using check_list_t = fixed_vector_t<kiki_t, max_check_size>;
+
+    /**
+     * @breif ̏
+     * @details 𒆐SƂ8ɂꂼꍂX1݂͑Ȃ߁AŒ蒷̔zŕێB
+     */
     class aigoma_info_t
-        : public std::unordered_map<position_t, std::vector<position_t>>
     {
     public:
-        using std::unordered_map<position_t, std::vector<position_t>>::unordered_map;
+        constexpr static std::size_t capacity = 8;
+
+        /**
+         * @breif ǉB
+         * @param position ̍W
+         * @param candidates ړ\ȍW̃rbg{[h
+         */
+        inline void add(position_t position, const bitboard_t & candidates) noexcept
+        {
+            SHOGIPP_ASSERT(m_size < capacity);
+            m_pinned.set(position);
+            m_position_list[m_size] = position;
+            m_candidates_list[m_size] = candidates;
+            ++m_size;
+        }
+
+        /**
+         * @breif ړ\ȍW̃rbg{[h擾B
+         * @param position W
+         * @return position ̏ꍇAړ\ȍW̃rbg{[hw|C^BȊȌꍇ nullptr
+         */
+        inline const bitboard_t * find(position_t position) const noexcept
+        {
+            if (!m_pinned.test(position))
+                return nullptr;
+            for (std::size_t i = 0; i < m_size; ++i)
+                if (m_position_list[i] == position)
+                    return &m_candidates_list[i];
+            SHOGIPP_ASSERT(false);
+            return nullptr;
+        }
+
+        /**
+         * @breif ̍W̃rbg{[h擾B
+         * @return ̍W̃rbg{[h
+         */
+        inline const bitboard_t & pinned() const noexcept
+        {
+            return m_pinned;
+        }
 
         inline void print() const
         {
-            for (const auto & [position, candidates] : *this)
-                std::cout << "F" << position_to_string(position) << std::endl;
+            for (std::size_t i = 0; i < m_size; ++i)
+                std::cout << "F" << position_to_string(m_position_list[i]) << std::endl;
         }
+
+    private:
+        bitboard_t m_pinned;
+        std::size_t m_size = 0;
+        position_t m_position_list[capacity]{};
+        bitboard_t m_candidates_list[capacity];
     };
 
     /**
@@ -3464,45 +4710,88 @@ namespace shogipp
         }
     };
 
+    /**
+     * @breif ̔Ɏgpǖʂ̏
+     */
+    class repetition_info_t
+    {
+    public:
+        hash_t hash;                        // ǖʂ̃nbVl
+        hash_t board_hash;                  // ǖʂ̃nbVl
+        captured_pieces_t captured_pieces;  // Ԃ̎
+        bool check;                         // Ԃɉ肪Ă邩
+    };
+
+    /**
+     * @breif ̔̌
+     */
+    enum class repetition_state_t
+    {
+        none,       // łȂ
+        draw,       // 
+        win,        // ̘A̐(Ԃ̏)
+        lose,       // Ԃ̘A̐(Ԃ̕)
+        superior,   // ՂŎԂ̎Dǖ
+        inferior    // ՂŎԂ̎Ȃ򓙋ǖ
+    };
+
+    /**
+     * @breif X^bNŊǗJԒn@̃nbVW
+     * @tparam Value ľ^
+     * @tparam Hash l̃nbV֐IuWFNǧ^
+     * @details l push Ƌt̏ pop 邽߁A pop l push ꂽl͊ɑ݂ȂB
+     *          ̂ pop ŋɂgoRĒTl݂͑AWg킸ɘgɂłB
+     *          l͘gLA push ꂽ񐔂𐔂B
+     *          g͍ŏ push ŊmۂB
+     */
     template<typename Value, typename Hash = std::hash<Value>>
-    class stack_set_t
+    class repetition_table_t
     {
     public:
         using value_type = Value;
-        using stack_type = std::deque<value_type>;
         using hash_type = Hash;
-        using unordered_set_type = std::unordered_set<value_type, hash_type>;
 
         /**
-         * @breif X^bNŊǗLbV\zB
+         * @breif ŏɊmۂg̐(2̗ݏ)
+         */
+        constexpr static std::size_t initial_capacity = 64;
+
+        inline repetition_table_t() = default;
+
+        /**
+         * @breif ύXȂl̏WƂX^bNŊǗnbVW\zB
+         * @param base ƂȂl̏W
+         * @details base ͕ɋLB
          */
-        inline stack_set_t()
+        inline explicit repetition_table_t(const std::shared_ptr<const repetition_table_t> & base)
+            : m_base{ base }
         {
         }
 
-        inline stack_set_t(const stack_set_t &) = default;
-        inline stack_set_t(stack_set_t &&) = default;
-        inline stack_set_t & operator =(const stack_set_t &) = default;
-        inline stack_set_t & operator =(stack_set_t &&) = default;
+        inline repetition_table_t(const repetition_table_t &) = default;
+        inline repetition_table_t(repetition_table_t &&) = default;
+        inline repetition_table_t & operator =(const repetition_table_t &) = default;
+        inline repetition_table_t & operator =(repetition_table_t &&) = default;
 
         /**
-         * @breif LbVjB
+         * @breif SĂ̒ljB
          */
-        inline void clear()
+        inline void clear() noexcept
         {
-            stack.clear();
-            uset.clear();
+            std::fill(m_entries.begin(), m_entries.end(), entry_t{});
+            m_stack.clear();
+            m_base.reset();
         }
 
         /**
-         * @breif lo^Ă邩肷B
-         * @param l
-         * @retval true lo^Ă
-         * @retval false lo^ĂȂ
+         * @breif lo^ꂽ񐔂擾B
+         * @param value l
+         * @return ܂߂Ēlo^ꂽ
          */
-        inline bool contains(value_type value) const
+        inline std::size_t count(value_type value) const noexcept
         {
-            return uset.find(value) != uset.end();
+            const std::size_t count = m_entries.empty() ? 0 : m_entries[find(value)].count;
+            return m_base ? count + m_base->count(value) : count;
         }
 
         /**
@@ -3511,26 +4800,79 @@ namespace shogipp
          */
         inline void push(value_type value)
         {
-            stack.emplace_back(value);
-            uset.insert(value);
+            if ((m_stack.size() + 1) * 2 > m_entries.size())
+                rehash(std::max(m_entries.size() * 2, initial_capacity));
+            insert(value);
+            m_stack.push_back(value);
         }
 
-        inline void pop()
+        /**
+         * @breif Ōɓo^ꂽl폜B
+         */
+        inline void pop() noexcept
         {
-            uset.erase(stack.back());
-            stack.pop_back();
+            SHOGIPP_ASSERT(!m_stack.empty());
+            entry_t & entry = m_entries[find(m_stack.back())];
+            SHOGIPP_ASSERT(entry.count > 0);
+            if (--entry.count == 0)
+                entry = entry_t{};
+            m_stack.pop_back();
         }
 
-    private:
-        stack_type stack;
-        unordered_set_type uset;
-    };
+        /**
+         * @breif ƂȂl̏W擾B
+         * @return ƂȂl̏W
+         */
+        inline const std::shared_ptr<const repetition_table_t> & base() const noexcept
+        {
+            return m_base;
+        }
 
-#ifdef SIZE_OF_HASH
-    using stack_cache_t = stack_set_t<hash_t, basic_hash_hasher_t<SIZE_OF_HASH>>;
-#else
-    using stack_cache_t = stack_set_t<hash_t>;
-#endif
+    private:
+        class entry_t
+        {
+        public:
+            value_type value{};
+            unsigned int count = 0;
+        };
+
+        std::vector<entry_t> m_entries;
+        std::vector<value_type> m_stack;
+        std::shared_ptr<const repetition_table_t> m_base;
+
+        /**
+         * @breif li[Ăg邢͒li[ׂ̘g̓Y擾B
+         * @param value l
+         * @return g̓Y
+         */
+        inline std::size_t find(value_type value) const noexcept
+        {
+            const std::size_t mask = m_entries.size() - 1;
+            std::size_t index = hash_type{}(value) & mask;
+            while (m_entries[index].count > 0 && !(m_entries[index].value == value))
+                index = (index + 1) & mask;
+            return index;
+        }
+
+        inline void insert(value_type value) noexcept
+        {
+            entry_t & entry = m_entries[find(value)];
+            entry.value = value;
+            ++entry.count;
+        }
+
+        inline void rehash(std::size_t capacity)
+        {
+            m_entries.assign(capacity, entry_t{});
+            for (const value_type & value : m_stack)
+                insert(value);
+        }
+    };
+
+    /**
+     * @breif ǖʂ̃nbVl̏W
+     */
+    using board_hash_table_t = repetition_table_t<hash_t, basic_hash_hasher_t<default_hash_size>>;
 
     /**
      * @breif ǖʂ̒ǉ
@@ -3539,10 +4881,38 @@ namespace shogipp
     class additional_info_t
     {
     public:
-        std::vector<std::vector<kiki_t>> check_list_stack;  // ԂɂĂ鉤
-        std::vector<hash_t> hash_stack;                     // ǖʂ̃nbVl
+        inline additional_info_t() = default;
+        inline additional_info_t(const additional_info_t &) = default;
+        inline additional_info_t(additional_info_t &&) = default;
+        inline additional_info_t & operator =(const additional_info_t &) = default;
+        inline additional_info_t & operator =(additional_info_t &&) = default;
+
+        std::vector<check_list_t> check_list_stack;         // ԂɂĂ鉤
+        std::vector<repetition_info_t> hash_stack;          // ǖʂ̃nbVlƐ̔Ɏgp
+        std::shared_ptr<const std::vector<repetition_info_t>> root_hash_stack; // ǖʂ𕡐_O hash_stack
+        board_hash_table_t board_hash_table;                // hash_stack  root_hash_stack ̎nbVl
         position_t king_position_list[color_t::size()]{};   // ̍W
-        stack_cache_t previously_done_moves;                // o̍@
+        bitboard_t color_bitboards[color_t::size()];        // ԂƂ̋̍W
+        bitboard_t piece_bitboards[noncolored_piece_size];  // ̎ނƂ̋̍W
+        unsigned char kiki_count_list[color_t::size()][file_size * rank_size]{}; // ԂƂ̊eWɗĂ̐
+        unsigned short pawn_files[color_t::size()]{};       // ԂƂ̐ĂȂ݂(ʂ file_size rbg)
+    };
+
+    /**
+     * @breif T̍ƂȂǖʂ̕
+     * @details ՁAA萔AnbVlѐ̔ɕKvȉߋ̋ǖʂ݂̏̂ێA≤̃X^bNAϑ҂ێȂB
+     *          ߋ̋ǖʂ̏͋L邽߁A͋ǖʂ̑傫ɔႷ鎞ԂŊB
+     */
+    class state_snapshot_t
+    {
+    public:
+        board_t board;                                                          // 
+        captured_pieces_t captured_pieces_list[color_t::size()];                // 
+        move_count_t move_count = 0;                                            // 萔
+        hash_t hash{};                                                          // ǖʂ̃nbVl
+        std::shared_ptr<const std::vector<repetition_info_t>> hash_stack;       // ߋ̋ǖʂ̏
+        std::shared_ptr<const board_hash_table_t> board_hash_table;             // hash_stack ̎nbVl
+        bool anti_repetition_of_moves = true;                                   // ϐ
     };
 
     class state_t;
@@ -3574,6 +4944,19 @@ namespace shogipp
          */
         inline state_t(std::string_view position);
 
+        /**
+         * @breif T̍ƂȂǖʂ̕ǖʂ\zB
+         * @param snapshot T̍ƂȂǖʂ̕
+         * @details Ȃǖʂ\zB undo_move  snapshot Őǖʂɖ߂Ƃ͂łȂB
+         */
+        inline explicit state_t(const state_snapshot_t & snapshot);
+
+        /**
+         * @breif T̍ƂȂǖʂ̕擾B
+         * @return T̍ƂȂǖʂ̕
+         */
+        inline state_snapshot_t snapshot() const;
+
         /**
          * @breif ړꍇɐ肪\肷B
          * @param piece 
@@ -3609,6 +4992,14 @@ namespace shogipp
         template<typename OutputIterator>
         inline void search_near_destination(OutputIterator result, position_t source, position_t offset) const;
 
+        /**
+         * @breif ړ̍Wړ\̈ړ̃rbg{[h擾B
+         * @param source ړ̍W
+         * @param color ǂ̎Ԃ̈ړ
+         * @return ړ̍W̃rbg{[h
+         */
+        inline bitboard_t destination_bitboard(position_t source, color_t color) const noexcept;
+
         /**
          * @breif ړ̍Wړ\̈ړB
          * @param result ړ̍W̏o̓Ce[^
@@ -3720,7 +5111,7 @@ namespace shogipp
          * @param color ア̎_
          * @return 
          */
-        std::vector<kiki_t> search_check(color_t color) const;
+        inline check_list_t search_check(color_t color) const;
 
         /**
          * @breif ǉpushB
@@ -3748,6 +5139,138 @@ namespace shogipp
          */
         inline void update_king_position_list();
 
+        /**
+         * @breif Ղrbg{[hXVB
+         */
+        inline void update_bitboards();
+
+        /**
+         * @breif ՂɋzuArbg{[hXVB
+         * @param position W
+         * @param piece 
+         * @details position ͋łȂ΂ȂȂB
+         */
+        inline void place_piece(position_t position, colored_piece_t piece);
+
+        /**
+         * @breif Ղ菜Arbg{[hXVB
+         * @param position W
+         * @details position ͋łĂ͂ȂȂB
+         */
+        inline void remove_piece(position_t position);
+
+        /**
+         * @breif ̗̐ZB
+         * @param color Ă̎
+         * @param attacks ̃rbg{[h
+         * @param delta Zl
+         */
+        inline void add_kiki_count(color_t color, bitboard_t attacks, int delta) noexcept;
+
+        /**
+         * @breif W position ʉ߂ы̗̐A position ̐̍WɂĉZB
+         * @param position W
+         * @param delta Zl
+         * @details position ɋzuO -1 A position 菜 +1 w肵ČĂяoB
+         */
+        inline void add_sliding_kiki_count_through(position_t position, int delta) noexcept;
+
+        /**
+         * @breif WpositionɗĂ̐擾B
+         * @param position W
+         * @param color ア̎_
+         * @return WpositionɗĂ color łȂ̐
+         * @details ǖʂ̒ǉ񂩂擾邽 O(1) œ삷B
+         */
+        inline std::size_t count_kiki(position_t position, color_t color) const noexcept;
+
+        /**
+         * @breif WpositionɕRtĂ̐擾B
+         * @param position W
+         * @param color ア̎_
+         * @return WpositionɗĂ color ̋̐
+         * @details ǖʂ̒ǉ񂩂擾邽 O(1) œ삷B
+         */
+        inline std::size_t count_himo(position_t position, color_t color) const noexcept;
+
+        /**
+         * @breif Տ̑SĂ̋̍W̃rbg{[h擾B
+         * @return Տ̑SĂ̋̍W̃rbg{[h
+         */
+        inline bitboard_t occupancy() const noexcept;
+
+        /**
+         * @breif Տ̎Ԃ̋̍W̃rbg{[h擾B
+         * @param color 
+         * @return Տ̎Ԃ̋̍W̃rbg{[h
+         */
+        inline const bitboard_t & occupancy(color_t color) const noexcept;
+
+        /**
+         * @breif Տ̋̍W̃rbg{[h擾B
+         * @param piece 
+         * @return Տ̋̍W̃rbg{[h
+         */
+        inline bitboard_t pieces(colored_piece_t piece) const noexcept;
+
+        /**
+         * @breif WɗĂ̍W̃rbg{[h擾B
+         * @param position W
+         * @param color Ă̎
+         * @param occupancy ы̗Ղ̍W̃rbg{[h
+         * @return WɗĂ color ̋̍W̃rbg{[h
+         * @details occupancy ɔՂƈقȂzu^邱ƂŁAɒu邢͎菜ǖʂ̗𓾂B
+         */
+        inline bitboard_t attackers_to(position_t position, color_t color, const bitboard_t & occupancy) const noexcept;
+
+        /**
+         * @breif WɗĂ̍W̃rbg{[h擾B
+         * @param position W
+         * @param color Ă̎
+         * @return WɗĂ color ̋̍W̃rbg{[h
+         */
+        inline bitboard_t attackers_to(position_t position, color_t color) const noexcept;
+
+        /**
+         * @breif WɋĂ邩肷B
+         * @param position W
+         * @param color Ă̎
+         * @param occupancy ы̗Ղ̍W̃rbg{[h
+         * @retval true W color ̋Ă
+         * @retval false W color ̋ĂȂ
+         * @details Ă1_ŔIB
+         */
+        inline bool is_attacked(position_t position, color_t color, const bitboard_t & occupancy) const noexcept;
+
+        /**
+         * @breif WɋĂ邩肷B
+         * @param position W
+         * @param color Ă̎
+         * @retval true W color ̋Ă
+         * @retval false W color ̋ĂȂ
+         * @details ǖʂ̒ǉ񂩂擾邽 O(1) œ삷B
+         */
+        inline bool is_attacked(position_t position, color_t color) const noexcept;
+
+        /**
+         * @breif ̕ł肪łl߂ɂȂ邩肷B
+         * @param destination łW
+         * @retval true łl߂ɂȂ
+         * @retval false łl߂ɂȂȂ
+         * @details destination ̑Oɑ݂̉ꍇɌĂяoB
+         *          @𐶐ÄړƉȊŐɂ̎擾݂̂𒲂ׂBɂ鉤͐ڐGł邽ߍlȂB
+         */
+        inline bool uchifuzume(position_t destination) const noexcept;
+
+        /**
+         * @breif Ƒ̔ы̊ԂɂB̋B
+         * @param blocker_info ̏o͐
+         * @param king_color ̎
+         * @param blocker_color ̎
+         * @details blocker_color == king_color ̏ꍇ͓BtɂꂽA blocker_color != king_color ̏ꍇ͓ƊJƂȂB
+         */
+        inline void search_blockers(aigoma_info_t & blocker_info, color_t king_color, color_t blocker_color) const;
+
         /**
          * @breif B
          * @param aigoma_info ̏o͐
@@ -3804,9 +5327,11 @@ namespace shogipp
         /**
          * @breif OȂ̂𓮂B
          * @param result @̏o̓Ce[^
+         * @param target ړ̍W̌̃rbg{[h
+         * @param unrestricted_sources target ɂ炸SĂ̈ړړ̍W̃rbg{[h
          */
         template<typename OutputIterator>
-        inline void search_moves_moves(OutputIterator result) const;
+        inline void search_moves_moves(OutputIterator result, const bitboard_t & target = bitboard_t::all(), const bitboard_t & unrestricted_sources = {}) const;
 
         /**
          * @breif OȂ̂łB
@@ -3815,6 +5340,41 @@ namespace shogipp
         template<typename OutputIterator>
         inline void search_moves_puts(OutputIterator result) const;
 
+        /**
+         * @breif ̎ނƂɁA̋ړƑ̉ɗW߂B
+         * @param check_squares ̎ނYƂo͐(̗vf͐ݒ肵Ȃ)
+         * @details ړ̗̋L͍lȂB
+         */
+        inline void search_check_squares(bitboard_t (&check_squares)[noncolored_piece_size]) const;
+
+        /**
+         * @breif @肪̉ɉ邩肷B
+         * @param move @
+         * @retval true 
+         * @retval false Ȃ
+         * @details ɂ钼ڂ̉ƁA̔w̔ыɂJ𔻒肷B
+         */
+        inline bool gives_check(const move_t & move) const;
+
+        /**
+         * @breif @肪̉ɉ邩肷B
+         * @param move @
+         * @param blocker_info search_blockers(blocker_info, !color(), color()) ŋ߂JƂȂ̏
+         * @retval true 
+         * @retval false Ȃ
+         * @details ǖʂŕ̎𔻒肷ꍇɁAJƂȂ̌xōς܂邽߂ɎgpB
+         */
+        inline bool gives_check(const move_t & move, const aigoma_info_t & blocker_info) const;
+
+        /**
+         * @breif 鍇@B
+         * @param result @̏o̓Ce[^
+         * @details ɗW̎ނƂɋ߁A̍WɈړ肨ъJƂȂ𓮂ɌĐB
+         *          o͂鍇@ɂ move_t::check_tag t^B
+         */
+        template<typename OutputIterator>
+        inline void search_checks(OutputIterator result) const;
+
         /**
          * @breif @B
          * @param result @̏o̓Ce[^
@@ -3847,6 +5407,13 @@ namespace shogipp
          */
         inline hash_t make_hash() const;
 
+        /**
+         * @breif ̎̃nbVlvZB
+         * @return ̎̃nbVl
+         * @details make_hash() Ƃ̊֐̖߂l̔rI_a͎ǖʂ̃nbVlƂȂB
+         */
+        inline hash_t make_captured_pieces_hash() const;
+
         /**
          * @breif ǖʂ̃nbVlƍ@肩A@{̋ǖʂ̃nbVlvZB
          * @param hash @{Őǖʂ̃nbVl
@@ -3971,7 +5538,33 @@ namespace shogipp
         /**
          * @breif @̏W폜B
          */
-        inline void remove_repetition_of_moves(moves_t & moves) const noexcept;
+        inline void remove_repetition_of_moves(moves_t & moves) const;
+
+        /**
+         * @breif @肪ߋƓ̋ǖʂɎ邩肷B
+         * @param move @
+         * @retval true ߋƓ̋ǖʂɎ
+         * @retval false ߋƓ̋ǖʂɎȂ
+         */
+        inline bool is_repetition_move(const move_t & move) const;
+
+        /**
+         * @breif 𔻒肷B
+         * @return ̔̌
+         * @details Ԃߋ̋ǖʂVɑkAŏɌ̋ǖʁADǖʂ邢͗򓙋ǖʂɂ蔻肷B
+         *          ɂ͋ǖʂ߂Ȃ肪݂Ȃ߁A̐擪܂őkB
+         *          ̋ǖʂ̊ԂňĂꍇAĂ̕ƂB
+         */
+        inline repetition_state_t repetition_state() const noexcept;
+
+        /**
+         * @breif 肪̋ǖʂɂč@ł邩肷B
+         * @param move 
+         * @retval true @ł
+         * @retval false @łȂ
+         * @details u\L[ȂǑ̋ǖʂœꂽ؂邽߂ɎgpB͍lȂB
+         */
+        inline bool is_legal(const move_t & move) const;
 
         /**
          * @breif ̍W擾B
@@ -3984,7 +5577,7 @@ namespace shogipp
          * @breif ԂɂĂ鉤擾B
          * @return ԂɂĂ鉤
          */
-        inline const std::vector<kiki_t> & check_list() const noexcept;
+        inline const check_list_t & check_list() const noexcept;
 
         inline void add_observer(const std::shared_ptr<observer_t> & observer);
         inline void remove_observer(const std::shared_ptr<observer_t> & observer);
@@ -4042,6 +5635,7 @@ namespace shogipp
 
     inline state_t::state_t()
     {
+        update_bitboards();
         update_king_position_list();
         push_additional_info();
         initial_sfen_string = "startpos";
@@ -4105,11 +5699,17 @@ namespace shogipp
                     colored_piece_t piece = *optional_piece;
                     if (promoted)
                         piece = piece.to_promoted();
+                    promoted = false;
                     temp.board[file_rank_to_position(file, rank)] = piece;
                     ++file;
                 }
             }
             temp.clear_additional_info();
+
+            // ̏W max_check_size eʂƂ邽߁A𒴂ɗǖʂ͎󂯕tȂB
+            for (const color_t color : colors)
+                if (!temp.pieces(colored_piece_t{ king, color }).empty() && temp.count_kiki(temp.king_position(color), color) > max_check_size)
+                    throw invalid_usi_input{ "too many checks" };
             temp.push_additional_info();
 
             ++current_token;
@@ -4120,7 +5720,10 @@ namespace shogipp
             if (*current_token == "w")
             {
                 ++current_token;
-                /* unused */;
+                // Ԃ͎萔̋狁߂邽߁AԂ̋ǖʂ͎萔1ƂAԂɈˑ鉤ȂǂvZB
+                temp.move_count = 1;
+                temp.clear_additional_info();
+                temp.push_additional_info();
             }
             else if (*current_token == "b")
             {
@@ -4161,6 +5764,7 @@ namespace shogipp
                             count = 0;
                             for (; iter != current_token->end() && *iter >= '0' && *iter <= '9'; ++iter)
                                 count = static_cast<captured_pieces_t::size_type>(count * 10 + *iter - '0');
+                            --iter; // ̒̋Õ[vœǂށB
                         }
                         else
                         {
@@ -4173,6 +5777,9 @@ namespace shogipp
                             count = 1;
                         }
                     }
+                    // ܂߂ănbVlvZB
+                    temp.clear_additional_info();
+                    temp.push_additional_info();
                     ++current_token;
                 }
             }
@@ -4182,6 +5789,49 @@ namespace shogipp
         initial_sfen_string = position;
     }
 
+    inline state_t::state_t(const state_snapshot_t & snapshot)
+        : board{ snapshot.board }
+        , move_count{ snapshot.move_count }
+        , anti_repetition_of_moves{ snapshot.anti_repetition_of_moves }
+    {
+        for (const color_t color : colors)
+            captured_pieces_list[color.value()] = snapshot.captured_pieces_list[color.value()];
+        additional_info.root_hash_stack = snapshot.hash_stack;
+        additional_info.board_hash_table = board_hash_table_t{ snapshot.board_hash_table };
+        update_bitboards();
+        update_king_position_list();
+        push_additional_info(snapshot.hash);
+    }
+
+    inline state_snapshot_t state_t::snapshot() const
+    {
+        state_snapshot_t snapshot;
+        snapshot.board = board;
+        for (const color_t color : colors)
+            snapshot.captured_pieces_list[color.value()] = captured_pieces_list[color.value()];
+        snapshot.move_count = move_count;
+        snapshot.hash = hash();
+        if (additional_info.hash_stack.size() > 1 || !additional_info.root_hash_stack)
+        {
+            const std::shared_ptr<std::vector<repetition_info_t>> hash_stack = std::make_shared<std::vector<repetition_info_t>>();
+            if (additional_info.root_hash_stack)
+                hash_stack->insert(hash_stack->end(), additional_info.root_hash_stack->begin(), additional_info.root_hash_stack->end());
+            hash_stack->insert(hash_stack->end(), additional_info.hash_stack.begin(), additional_info.hash_stack.end() - 1);
+            snapshot.hash_stack = hash_stack;
+            const std::shared_ptr<board_hash_table_t> board_hash_table = std::make_shared<board_hash_table_t>();
+            for (const repetition_info_t & info : *hash_stack)
+                board_hash_table->push(info.board_hash);
+            snapshot.board_hash_table = board_hash_table;
+        }
+        else
+        {
+            snapshot.hash_stack = additional_info.root_hash_stack;
+            snapshot.board_hash_table = additional_info.board_hash_table.base();
+        }
+        snapshot.anti_repetition_of_moves = anti_repetition_of_moves;
+        return snapshot;
+    }
+
     inline bool state_t::promotable(colored_piece_t piece, position_t source, position_t destination)
     {
         if (!piece.is_promotable())
@@ -4211,17 +5861,9 @@ namespace shogipp
     template<typename OutputIterator>
     inline void state_t::search_far_destination(OutputIterator result, position_t source, position_t offset) const
     {
-        for (position_t current = source + offset; !board_t::out(current); current += offset)
-        {
-            if (board[current].empty())
-                *result++ = current;
-            else
-            {
-                if (board[source].to_color() == board[current].to_color()) break;
-                *result++ = current;
-                if (board[source].to_color() != board[current].to_color()) break;
-            }
-        }
+        bitboard_t destinations = sliding_attack_table.ray_attacks(source, offset, occupancy()) & ~occupancy(board[source].to_color());
+        while (!destinations.empty())
+            *result++ = destinations.pop();
     }
 
     template<typename OutputIterator>
@@ -4232,14 +5874,18 @@ namespace shogipp
             *result++ = current;
     }
 
+    inline bitboard_t state_t::destination_bitboard(position_t source, color_t color) const noexcept
+    {
+        const colored_piece_t piece{ noncolored_piece_t{ board[source] }, color };
+        return piece_attacks(piece, source, occupancy()) & ~occupancy(board[source].to_color());
+    }
+
     template<typename OutputIterator>
     inline void state_t::search_destination(OutputIterator result, position_t source, color_t color) const
     {
-        const noncolored_piece_t piece{ board[source] };
-        for (const position_t * offset = far_move_offsets(piece); *offset; ++offset)
-            search_far_destination(result, source, *offset * reverse(color));
-        for (const position_t * offset = near_move_offsets(piece); *offset; ++offset)
-            search_near_destination(result, source, *offset * reverse(color));
+        bitboard_t destinations = destination_bitboard(source, color);
+        while (!destinations.empty())
+            *result++ = destinations.pop();
     }
 
     inline bool state_t::puttable(captured_piece_t piece, position_t destination) const
@@ -4262,29 +5908,15 @@ namespace shogipp
         }
         if (piece == captured_pawn)
         {
-            const position_t file = position_to_file(destination);
-
             // 
-            for (position_t rank = 0; rank < rank_size; ++rank)
-            {
-                const colored_piece_t current = board[file_rank_to_position(file, rank)];
-                if (!current.empty() && noncolored_piece_t{ current } == pawn && color() == current.to_color())
-                    return false;
-            }
+            if (additional_info.pawn_files[color().value()] & (1 << position_to_file(destination)))
+                return false;
 
             // łl
             const position_t position = destination + front * (reverse(color()));
             if (!board_t::out(position) && !board[position].empty() && noncolored_piece_t{ board[position] } == king && board[position].to_color() != color())
             {
-                const move_t move{ destination, piece };
-                moves_t moves;
-                {
-                    VALIDATE_STATE_ROLLBACK(*this);
-                    const_cast<state_t &>(*this).do_move(move);
-                    moves = search_moves();
-                    const_cast<state_t &>(*this).undo_move();
-                }
-                if (moves.empty())
+                if (uchifuzume(destination))
                     return false;
             }
         }
@@ -4294,18 +5926,17 @@ namespace shogipp
     template<typename OutputIterator>
     inline void state_t::search_source(OutputIterator result, color_t color) const
     {
-        for (position_t position = position_begin; position < position_end; ++position)
-            if (!board_t::out(position) && !board[position].empty() && board[position].to_color() == color)
-                *result++ = position;
+        bitboard_t sources = occupancy(color);
+        while (!sources.empty())
+            *result++ = sources.pop();
     }
 
     inline position_t state_t::search(position_t position, position_t offset) const
     {
-        position_t current;
-        for (current = position + offset; !board_t::out(current) && board[current].empty(); current += offset);
-        if (board_t::out(current))
+        const bitboard_t found = sliding_attack_table.ray_attacks(position, offset, occupancy()) & occupancy();
+        if (found.empty())
             return npos;
-        return current;
+        return found.front();
     }
 
     template<typename OutputIterator, typename InputIterator, typename IsCollected, typename Transform>
@@ -4365,9 +5996,9 @@ namespace shogipp
         search_kiki(result, additional_info.king_position_list[color.value()], color);
     }
 
-    std::vector<kiki_t> state_t::search_check(color_t color) const
+    inline check_list_t state_t::search_check(color_t color) const
     {
-        std::vector<kiki_t> check_list;
+        check_list_t check_list;
         search_check(std::back_inserter(check_list), color);
         return check_list;
     }
@@ -4379,13 +6010,11 @@ namespace shogipp
 
     inline void state_t::push_additional_info(hash_t hash)
     {
-        additional_info.check_list_stack.push_back(search_check(color()));
-        additional_info.hash_stack.push_back(hash);
-        if (!kifu.empty())
-        {
-            const hash_t hash = this->hash() ^ hash_table.move_hash(kifu.back(), !color());
-            additional_info.previously_done_moves.push(hash);
-        }
+        check_list_t & check_list = additional_info.check_list_stack.emplace_back();
+        search_check(std::back_inserter(check_list), color());
+        const hash_t board_hash = hash ^ make_captured_pieces_hash();
+        additional_info.hash_stack.push_back({ hash, board_hash, captured_pieces_list[color().value()], !check_list.empty() });
+        additional_info.board_hash_table.push(board_hash);
     }
 
     inline void state_t::pop_additional_info()
@@ -4394,208 +6023,370 @@ namespace shogipp
         SHOGIPP_ASSERT(!additional_info.hash_stack.empty());
         additional_info.check_list_stack.pop_back();
         additional_info.hash_stack.pop_back();
-        additional_info.previously_done_moves.pop();
+        additional_info.board_hash_table.pop();
     }
 
     inline void state_t::clear_additional_info()
     {
         additional_info.check_list_stack.clear();
         additional_info.hash_stack.clear();
+        additional_info.root_hash_stack.reset();
+        additional_info.board_hash_table.clear();
+        update_bitboards();
         update_king_position_list();
-        additional_info.previously_done_moves.clear();
     }
 
     inline void state_t::update_king_position_list()
     {
-        for (position_t position = position_begin; position < position_end; ++position)
-            if (!board_t::out(position) && !board[position].empty() && noncolored_piece_t{ board[position] } == king)
-                additional_info.king_position_list[board[position].to_color().value()] = position;
+        for (const color_t color : colors)
+            if (const bitboard_t kings = pieces(colored_piece_t{ king, color }); !kings.empty())
+                additional_info.king_position_list[color.value()] = kings.front();
     }
 
-    inline void state_t::search_aigoma(aigoma_info_t & aigoma_info, color_t color) const
+    inline void state_t::update_bitboards()
     {
-        using pair = std::pair<position_t, std::vector<noncolored_piece_t>>;
-        static const std::vector<pair> table
-        {
-            { front      , { lance, rook, promoted_rook } },
-            { left       , { rook, promoted_rook } },
-            { right      , { rook, promoted_rook } },
-            { back       , { rook, promoted_rook } },
-            { front_left , { bishop, promoted_bishop } },
-            { front_right, { bishop, promoted_bishop } },
-            { back_left  , { bishop, promoted_bishop } },
-            { back_right , { bishop, promoted_bishop } },
-        };
-
-        const position_t king_position = additional_info.king_position_list[color.value()];
-        for (const auto & [offset, hashirigoma_list] : table)
+        for (bitboard_t & bitboard : additional_info.color_bitboards)
+            bitboard = bitboard_t{};
+        for (bitboard_t & bitboard : additional_info.piece_bitboards)
+            bitboard = bitboard_t{};
+        for (unsigned short & pawn_files : additional_info.pawn_files)
+            pawn_files = 0;
+        for (position_t position = position_begin; position < position_end; ++position)
         {
-            const position_t reversed_offset = offset * reverse(color);
-            const position_t first = search(king_position, reversed_offset);
-            if (first != npos && board[first].to_color() == color)
+            if (!board_t::out(position) && !board[position].empty())
             {
-                const position_t second = search(first, reversed_offset);
-                if (second != npos && board[second].to_color() != color)
-                {
-                    const noncolored_piece_t kind = noncolored_piece_t{ board[second] };
-                    bool match = std::find(hashirigoma_list.begin(), hashirigoma_list.end(), kind) != hashirigoma_list.end();
-                    if (match)
-                    {
-                        std::vector<position_t> candidates;
-                        for (position_t candidate = second; candidate != king_position; candidate -= reversed_offset)
-                            candidates.push_back(candidate);
-                        aigoma_info[first] = std::move(candidates);
-                    }
-                }
+                additional_info.color_bitboards[board[position].to_color().value()].set(position);
+                additional_info.piece_bitboards[noncolored_piece_t{ board[position] }.value()].set(position);
+                if (noncolored_piece_t{ board[position] } == pawn)
+                    additional_info.pawn_files[board[position].to_color().value()] |= 1 << position_to_file(position);
             }
         }
-    }
 
-    inline aigoma_info_t state_t::search_aigoma(color_t color) const
-    {
-        aigoma_info_t aigoma_info;
-        search_aigoma(aigoma_info, color);
-        return aigoma_info;
+        for (auto & kiki_count : additional_info.kiki_count_list)
+            std::fill(std::begin(kiki_count), std::end(kiki_count), 0);
+        bitboard_t sources = occupancy();
+        while (!sources.empty())
+        {
+            const position_t source = sources.pop();
+            add_kiki_count(board[source].to_color(), piece_attacks(board[source], source, occupancy()), 1);
+        }
     }
 
-    template<typename OutputIterator>
-    inline void state_t::search_moves_from_positions(OutputIterator result, position_t source, position_t destination, move_t::tag_t tag) const
+    inline void state_t::place_piece(position_t position, colored_piece_t piece)
     {
-        if (promotable(board[source], source, destination))
-            *result++ = { source, destination, board[source], board[destination], true, static_cast<move_t::tag_t>(tag | move_t::promote_tag) };
-        if (!must_promote(board[source], destination))
-            *result++ = { source, destination, board[source], board[destination], false, tag };
+        SHOGIPP_ASSERT(board[position].empty());
+        SHOGIPP_ASSERT(!piece.empty());
+        add_sliding_kiki_count_through(position, -1);
+        board[position] = piece;
+        additional_info.color_bitboards[piece.to_color().value()].set(position);
+        additional_info.piece_bitboards[noncolored_piece_t{ piece }.value()].set(position);
+        if (noncolored_piece_t{ piece } == pawn)
+            additional_info.pawn_files[piece.to_color().value()] |= 1 << position_to_file(position);
+        add_kiki_count(piece.to_color(), piece_attacks(piece, position, occupancy()), 1);
     }
 
-    template<typename OutputIterator>
-    inline void state_t::search_moves_nonescapes(OutputIterator result) const
+    inline void state_t::remove_piece(position_t position)
     {
-        search_moves_moves(result);
-        search_moves_puts(result);
+        const colored_piece_t piece = board[position];
+        SHOGIPP_ASSERT(!piece.empty());
+        add_kiki_count(piece.to_color(), piece_attacks(piece, position, occupancy()), -1);
+        additional_info.color_bitboards[piece.to_color().value()].reset(position);
+        additional_info.piece_bitboards[noncolored_piece_t{ piece }.value()].reset(position);
+        if (noncolored_piece_t{ piece } == pawn && (pieces(piece) & file_table(position_to_file(position))).empty())
+            additional_info.pawn_files[piece.to_color().value()] &= ~(1 << position_to_file(position));
+        board[position] = colored_piece_t{};
+        add_sliding_kiki_count_through(position, 1);
     }
 
-    template<typename OutputIterator>
-    inline void state_t::search_moves_escapes_king_move(OutputIterator result) const
+    inline void state_t::add_kiki_count(color_t color, bitboard_t attacks, int delta) noexcept
     {
-        const position_t source = additional_info.king_position_list[color().value()];
-        for (const position_t * ptr = near_move_offsets(king); *ptr; ++ptr)
-        {
-            const position_t destination = source + *ptr * reverse(color());
-            if (!board_t::out(destination)
-                && (board[destination].empty() || board[destination].to_color() != color()))
-            {
-                const move_t move{ source, destination, board[source], board[destination], false, move_t::escape_tag };
-                std::vector<kiki_t> kiki;
-                {
-                    VALIDATE_STATE_ROLLBACK(*this);
-                    state_t & nonconst_this = const_cast<state_t &>(*this);
-                    const colored_piece_t captured = board[destination];
-                    nonconst_this.board[destination] = board[source];
-                    nonconst_this.board[source] = colored_piece_t{};
-                    search_kiki(std::back_inserter(kiki), destination, color());
-                    nonconst_this.board[source] = board[destination];
-                    nonconst_this.board[destination] = captured;
-                }
-                if (kiki.empty())
-                    *result++ = move;
-            }
-        }
+        unsigned char * kiki_count = additional_info.kiki_count_list[color.value()];
+        while (!attacks.empty())
+            kiki_count[attacks.pop9x9()] += static_cast<unsigned char>(delta);
     }
 
-    template<typename OutputIterator>
-    inline void state_t::search_moves_escapes_aigoma(OutputIterator result) const
+    inline void state_t::add_sliding_kiki_count_through(position_t position, int delta) noexcept
     {
-        const aigoma_info_t aigoma_info = search_aigoma(color());
-        const position_t king_pos = additional_info.king_position_list[color().value()];
+        using line_t = sliding_attack_table_t::line_t;
+        static constexpr position_t line_offsets[]{ back, right, back_right, back_left };
 
-        SHOGIPP_ASSERT(move_count < additional_info.check_list_stack.size());
-        const std::size_t saved_count = check_list().size();
+        const bitboard_t occupied = occupancy();
+        const bitboard_t * piece_bitboards = additional_info.piece_bitboards;
+        const bitboard_t orthogonal = piece_bitboards[rook_value] | piece_bitboards[promoted_rook_value];
+        const bitboard_t diagonal = piece_bitboards[bishop_value] | piece_bitboards[promoted_bishop_value];
 
-        // łۂɑłl߂𔻒肷邽 puttable  do_move / undo_move ĂяoB
-        //  additional_info.check_list_stack ̗vf̎QƂ[JϐƂĕێĂ͂ȂȂB
-        if (check_list().size() == 1)
+        for (std::size_t line = 0; line < sliding_attack_table_t::line_size; ++line)
         {
-            if (check_list().front().aigoma)
+            // ōŏɌы position ̕ɔIɗꍇA̗ position ʉ߂B
+            bitboard_t candidates = sliding_attack_table.line_attacks(static_cast<line_t>(line), position, occupied);
+            switch (line)
             {
-                const position_t offset = check_list().front().offset;
-                for (position_t destination = king_pos + offset; !board_t::out(destination) && board[destination].empty(); destination += offset)
-                {
-                    // ړ鍇
-                    std::vector<kiki_t> kiki_list;
-                    search_kiki(std::back_inserter(kiki_list), destination, !color());
-                    for (const kiki_t & kiki : kiki_list)
-                    {
-                        // ō͂łȂB
-                        if (noncolored_piece_t{ board[kiki.position] } != king)
-                        {
-                            // ɍƂĎgĂ͈ړłȂB
-                            const auto aigoma_iter = aigoma_info.find(kiki.position);
-                            const bool is_aigoma = aigoma_iter != aigoma_info.end();
-                            if (!is_aigoma)
-                                search_moves_from_positions(result, kiki.position, destination, move_t::escape_tag | move_t::capture_tag);
-                        }
-                    }
-
-                    // ł
-                    for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
-                        if (captured_pieces_list[color().value()][piece])
-                            if (puttable(piece, destination))
-                                *result++ = { destination, piece, move_t::escape_tag | move_t::aigoma_tag | move_t::put_tag };
-                }
+            case line_t::file_line:
+                candidates &= orthogonal | piece_bitboards[lance_value];
+                break;
+            case line_t::rank_line:
+                candidates &= orthogonal;
+                break;
+            default:
+                candidates &= diagonal;
+                break;
             }
-
-            if (check_list().size() != saved_count)
-                std::cerr << sfen_string() << std::endl;
-            // 肵ĂB
-            const position_t destination = check_list().front().position;
-            std::vector<kiki_t> kiki_list;
-            search_kiki(std::back_inserter(kiki_list), destination, !color());
-            for (const kiki_t & kiki : kiki_list)
-            {
-                // 𓮂͊Ɍς
-                if (noncolored_piece_t{ board[kiki.position] } != king)
-                {
-                    // ɍƂĎgĂ͈ړłȂB
-                    const auto aigoma_iter = aigoma_info.find(kiki.position);
-                    const bool is_aigoma = aigoma_iter != aigoma_info.end();
-                    if (!is_aigoma)
-                        search_moves_from_positions(result, kiki.position, destination, move_t::escape_tag | move_t::capture_tag);
-                }
+            while (!candidates.empty())
+            {
+                const position_t source = candidates.pop();
+                const position_t offset = source < position ? line_offsets[line] : -line_offsets[line];
+                if (is_sliding(board[source], offset))
+                    add_kiki_count(board[source].to_color(), sliding_attack_table.ray_attacks(position, offset, occupied), delta);
             }
         }
     }
 
-    template<typename OutputIterator>
-    inline void state_t::search_moves_escapes(OutputIterator result) const
+    inline std::size_t state_t::count_kiki(position_t position, color_t color) const noexcept
     {
-        search_moves_escapes_king_move(result);
-        search_moves_escapes_aigoma(result);
+        return additional_info.kiki_count_list[(!color).value()][position_to_position9x9(position)];
     }
 
-    /**
-     * @breif OȂ̂𓮂B
-     * @param result @̏o̓Ce[^
-     */
-    template<typename OutputIterator>
-    inline void state_t::search_moves_moves(OutputIterator result) const
+    inline std::size_t state_t::count_himo(position_t position, color_t color) const noexcept
     {
-        const aigoma_info_t aigoma_info = search_aigoma(color());
-        std::vector<position_t> source_list;
-        source_list.reserve(position_size);
-        search_source(std::back_inserter(source_list), color());
-        for (const position_t source : source_list)
-        {
-            std::vector<position_t> destination_list;
-            destination_list.reserve(position_size);
-            search_destination(std::back_inserter(destination_list), source, color());
-            const auto aigoma_iter = aigoma_info.find(source);
-            const bool is_aigoma = aigoma_iter != aigoma_info.end();
+        return additional_info.kiki_count_list[color.value()][position_to_position9x9(position)];
+    }
 
-            for (const position_t destination : destination_list)
-            {
-#ifndef NDEBUG
-                if (!board[destination].empty() && noncolored_piece_t { board[destination] } == king)
-                {
+    inline bitboard_t state_t::occupancy() const noexcept
+    {
+        return additional_info.color_bitboards[black.value()] | additional_info.color_bitboards[white.value()];
+    }
+
+    inline const bitboard_t & state_t::occupancy(color_t color) const noexcept
+    {
+        return additional_info.color_bitboards[color.value()];
+    }
+
+    inline bitboard_t state_t::pieces(colored_piece_t piece) const noexcept
+    {
+        SHOGIPP_ASSERT(!piece.empty());
+        return additional_info.color_bitboards[piece.to_color().value()] & additional_info.piece_bitboards[noncolored_piece_t{ piece }.value()];
+    }
+
+    inline bitboard_t state_t::attackers_to(position_t position, color_t color, const bitboard_t & occupancy) const noexcept
+    {
+        // ̋ position ɒuꍇ̗ color ̋̈ʒudȂ position ɗB
+        bitboard_t attackers;
+        for (piece_value_t piece = pawn_value; piece < noncolored_piece_size; ++piece)
+        {
+            const bitboard_t & candidates = additional_info.piece_bitboards[piece];
+            if (!candidates.empty())
+                attackers |= piece_attacks(colored_piece_t{ noncolored_piece_t{ piece }, !color }, position, occupancy) & candidates;
+        }
+        return attackers & this->occupancy(color);
+    }
+
+    inline bitboard_t state_t::attackers_to(position_t position, color_t color) const noexcept
+    {
+        return attackers_to(position, color, occupancy());
+    }
+
+    inline bool state_t::is_attacked(position_t position, color_t color, const bitboard_t & occupancy) const noexcept
+    {
+        const bitboard_t & colored_pieces = this->occupancy(color);
+        for (piece_value_t piece = pawn_value; piece < noncolored_piece_size; ++piece)
+        {
+            const bitboard_t candidates = additional_info.piece_bitboards[piece] & colored_pieces;
+            if (!candidates.empty() && !(piece_attacks(colored_piece_t{ noncolored_piece_t{ piece }, !color }, position, occupancy) & candidates).empty())
+                return true;
+        }
+        return false;
+    }
+
+    inline bool state_t::is_attacked(position_t position, color_t color) const noexcept
+    {
+        return additional_info.kiki_count_list[color.value()][position_to_position9x9(position)] > 0;
+    }
+
+    inline bool state_t::uchifuzume(position_t destination) const noexcept
+    {
+        const color_t enemy = !color();
+        const position_t king_position = additional_info.king_position_list[enemy.value()];
+        SHOGIPP_ASSERT(king_position == destination + front * reverse(color()));
+
+        // łՏ̋̔zu
+        bitboard_t occupied = occupancy();
+        occupied.set(destination);
+
+        // ̂ȂWɈړłꍇ(܂)Al݂łȂB̔w֒ʉ߂ы̗𓾂邽߁A菜B
+        bitboard_t occupied_without_king = occupied;
+        occupied_without_king.reset(king_position);
+        bitboard_t destinations = step_attack_table(board[king_position], king_position) & ~occupancy(enemy);
+        while (!destinations.empty())
+            if (!is_attacked(destinations.pop(), color(), occupied_without_king))
+                return false;
+
+        // ȊŐŕꍇAl݂łȂBAƑ̔ы̊ԂɓBtɂꂽ͕̍WBt̒ɂꍇɌB
+        bitboard_t capturers = attackers_to(destination, enemy, occupied);
+        capturers.reset(king_position);
+        if (!capturers.empty())
+        {
+            const aigoma_info_t aigoma_info = search_aigoma(enemy);
+            while (!capturers.empty())
+            {
+                const bitboard_t * candidates = aigoma_info.find(capturers.pop());
+                if (!candidates || candidates->test(destination))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline void state_t::search_blockers(aigoma_info_t & blocker_info, color_t king_color, color_t blocker_color) const
+    {
+        const position_t king_position = additional_info.king_position_list[king_color.value()];
+        const bitboard_t * piece_bitboards = additional_info.piece_bitboards;
+
+        // Տɋ݂ȂƂ݂Ȃꍇɉɗʒuɂ鑊̔ы
+        bitboard_t snipers = sliding_attack_table(colored_piece_t{ rook, king_color }, king_position, bitboard_t{})
+            & (piece_bitboards[rook_value] | piece_bitboards[promoted_rook_value]);
+        snipers |= sliding_attack_table(colored_piece_t{ bishop, king_color }, king_position, bitboard_t{})
+            & (piece_bitboards[bishop_value] | piece_bitboards[promoted_bishop_value]);
+        snipers |= sliding_attack_table(colored_piece_t{ lance, king_color }, king_position, bitboard_t{})
+            & piece_bitboards[lance_value];
+        snipers &= occupancy(!king_color);
+
+        const bitboard_t occupied = occupancy();
+        while (!snipers.empty())
+        {
+            const position_t sniper = snipers.pop();
+            const bitboard_t & between = between_table(king_position, sniper);
+            const bitboard_t blockers = between & occupied;
+            if (blockers.count() == 1 && !(blockers & occupancy(blocker_color)).empty())
+            {
+                bitboard_t candidates = between;
+                candidates.set(sniper);
+                blocker_info.add(blockers.front(), candidates);
+            }
+        }
+    }
+
+    inline void state_t::search_aigoma(aigoma_info_t & aigoma_info, color_t color) const
+    {
+        search_blockers(aigoma_info, color, color);
+    }
+
+    inline aigoma_info_t state_t::search_aigoma(color_t color) const
+    {
+        aigoma_info_t aigoma_info;
+        search_aigoma(aigoma_info, color);
+        return aigoma_info;
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_moves_from_positions(OutputIterator result, position_t source, position_t destination, move_t::tag_t tag) const
+    {
+        if (promotable(board[source], source, destination))
+            *result++ = { source, destination, board[source], board[destination], true, static_cast<move_t::tag_t>(tag | move_t::promote_tag) };
+        if (!must_promote(board[source], destination))
+            *result++ = { source, destination, board[source], board[destination], false, tag };
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_moves_nonescapes(OutputIterator result) const
+    {
+        search_moves_moves(result);
+        search_moves_puts(result);
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_moves_escapes_king_move(OutputIterator result) const
+    {
+        const position_t source = additional_info.king_position_list[color().value()];
+        const colored_piece_t king_piece = board[source];
+        bitboard_t destinations = step_attack_table(king_piece, source) & ~occupancy(color());
+
+        // 菜̔zuŔ肷ƁA̔w֒ʉ߂ы̗܂߂ĈړɗĂ邩B
+        bitboard_t occupied_without_king = occupancy();
+        occupied_without_king.reset(source);
+        while (!destinations.empty())
+        {
+            const position_t destination = destinations.pop();
+            if (!is_attacked(destination, !color(), occupied_without_king))
+                *result++ = move_t{ source, destination, king_piece, board[destination], false, move_t::escape_tag };
+        }
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_moves_escapes_aigoma(OutputIterator result) const
+    {
+        const aigoma_info_t aigoma_info = search_aigoma(color());
+        const position_t king_pos = additional_info.king_position_list[color().value()];
+
+        SHOGIPP_ASSERT(!additional_info.check_list_stack.empty());
+        const std::size_t saved_count = check_list().size();
+
+        if (check_list().size() == 1)
+        {
+            if (check_list().front().aigoma)
+            {
+                const position_t offset = check_list().front().offset;
+                for (position_t destination = king_pos + offset; !board_t::out(destination) && board[destination].empty(); destination += offset)
+                {
+                    // ړ鍇Bō͂łAɍƂĎgĂ͈ړłȂB
+                    bitboard_t sources = attackers_to(destination, color()) & ~aigoma_info.pinned();
+                    sources.reset(king_pos);
+                    while (!sources.empty())
+                        search_moves_from_positions(result, sources.pop(), destination, move_t::escape_tag | move_t::capture_tag);
+
+                    // ł
+                    for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
+                        if (captured_pieces_list[color().value()][piece])
+                            if (puttable(piece, destination))
+                                *result++ = { destination, piece, move_t::escape_tag | move_t::aigoma_tag | move_t::put_tag };
+                }
+            }
+
+            if (check_list().size() != saved_count)
+                std::cerr << sfen_string() << std::endl;
+            // 肵ĂB
+            // 𓮂͊Ɍς݂łAɍƂĎgĂ͈ړłȂB
+            const position_t destination = check_list().front().position;
+            bitboard_t sources = attackers_to(destination, color()) & ~aigoma_info.pinned();
+            sources.reset(king_pos);
+            while (!sources.empty())
+                search_moves_from_positions(result, sources.pop(), destination, move_t::escape_tag | move_t::capture_tag);
+        }
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_moves_escapes(OutputIterator result) const
+    {
+        search_moves_escapes_king_move(result);
+        search_moves_escapes_aigoma(result);
+    }
+
+    /**
+     * @breif OȂ̂𓮂B
+     * @param result @̏o̓Ce[^
+     */
+    template<typename OutputIterator>
+    inline void state_t::search_moves_moves(OutputIterator result, const bitboard_t & target, const bitboard_t & unrestricted_sources) const
+    {
+        const aigoma_info_t aigoma_info = search_aigoma(color());
+        bitboard_t sources = occupancy(color());
+        while (!sources.empty())
+        {
+            const position_t source = sources.pop();
+            bitboard_t destinations = destination_bitboard(source, color());
+            if (!unrestricted_sources.test(source))
+                destinations &= target;
+
+            // ͈͗̔͂ɂړłȂB
+            if (const bitboard_t * candidates = aigoma_info.find(source))
+                destinations &= *candidates;
+
+            while (!destinations.empty())
+            {
+                const position_t destination = destinations.pop();
+#ifndef NDEBUG
+                if (!board[destination].empty() && noncolored_piece_t { board[destination] } == king)
+                {
                     board.print();
                     std::cout << position_to_string(source) << std::endl;
                     const move_t move{ source, destination, board[source], board[destination], false };
@@ -4606,22 +6397,9 @@ namespace shogipp
                 }
 #endif
 
-                // ͈͗̔͂ɂړłȂB
-                if (is_aigoma)
-                {
-                    const std::vector<position_t> & candidates = aigoma_iter->second;
-                    if (std::find(candidates.begin(), candidates.end(), destination) == candidates.end())
-                        continue;
-                }
-
                 // ĂꏊɉړĂ͂ȂȂ
-                if (noncolored_piece_t{ board[source] } == king)
-                {
-                    std::vector<kiki_t> kiki_list;
-                    search_kiki(std::back_inserter(kiki_list), destination, color());
-                    if (kiki_list.size() > 0)
-                        continue;
-                }
+                if (noncolored_piece_t{ board[source] } == king && is_attacked(destination, !color()))
+                    continue;
 
                 search_moves_from_positions(result, source, destination, move_t::none_tag);
             }
@@ -4631,18 +6409,136 @@ namespace shogipp
     template<typename OutputIterator>
     inline void state_t::search_moves_puts(OutputIterator result) const
     {
+        const bitboard_t empty_positions = ~occupancy();
         for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
+        {
             if (captured_pieces_list[color().value()][piece])
-                for (position_t destination = position_begin; destination < position_end; ++destination)
+            {
+                bitboard_t destinations = empty_positions;
+
+                // ƂȂ؂ꊇďB
+                if (piece == pawn_value)
+                    for (position_t file = 0; file < file_size; ++file)
+                        if (additional_info.pawn_files[color().value()] & (1 << file))
+                            destinations &= ~file_table(file);
+
+                while (!destinations.empty())
+                {
+                    const position_t destination = destinations.pop();
                     if (puttable(piece, destination))
                         *result++ = { destination, piece };
+                }
+            }
+        }
+    }
+
+    inline void state_t::search_check_squares(bitboard_t (&check_squares)[noncolored_piece_size]) const
+    {
+        const color_t enemy = !color();
+        const position_t king_position = additional_info.king_position_list[enemy.value()];
+        const bitboard_t occupied = occupancy();
+        for (piece_value_t piece = pawn_value; piece < noncolored_piece_size; ++piece)
+            if (piece != king_value)
+                check_squares[piece] = piece_attacks(colored_piece_t{ noncolored_piece_t{ piece }, enemy }, king_position, occupied);
+    }
+
+    inline bool state_t::gives_check(const move_t & move) const
+    {
+        aigoma_info_t blocker_info;
+        if (!move.put())
+            search_blockers(blocker_info, !color(), color());
+        return gives_check(move, blocker_info);
+    }
+
+    inline bool state_t::gives_check(const move_t & move, const aigoma_info_t & blocker_info) const
+    {
+        const position_t king_position = additional_info.king_position_list[(!color()).value()];
+        bitboard_t occupied = occupancy();
+        occupied.set(move.destination());
+
+        // ɂ鉤
+        colored_piece_t piece;
+        if (move.put())
+            piece = colored_piece_t{ move.captured_piece(), color() };
+        else
+        {
+            occupied.reset(move.source());
+            piece = move.promote() ? move.source_piece().to_promoted() : move.source_piece();
+        }
+        if (piece_attacks(piece, move.destination(), occupied).test(king_position))
+            return true;
+
+        // J
+        if (!move.put())
+            if (const bitboard_t * candidates = blocker_info.find(move.source()))
+                return !candidates->test(move.destination());
+        return false;
+    }
+
+    template<typename OutputIterator>
+    inline void state_t::search_checks(OutputIterator result) const
+    {
+        const auto output = [&](const move_t & move)
+        {
+            if (move.put())
+                *result++ = { move.destination(), move.captured_piece(), static_cast<move_t::tag_t>(move.tag() | move_t::check_tag) };
+            else
+                *result++ = { move.source(), move.destination(), move.source_piece(), move.destination_piece(), move.promote(), static_cast<move_t::tag_t>(move.tag() | move_t::check_tag) };
+        };
+
+        // ƊJƂȂ
+        const color_t enemy = !color();
+        aigoma_info_t blocker_info;
+        search_blockers(blocker_info, enemy, color());
+
+        moves_t moves;
+        if (!check_list().empty())
+        {
+            // O͐Ȃ߁ASĐĔ肷B
+            search_moves_escapes(std::back_inserter(moves));
+            for (const move_t & move : moves)
+                if (gives_check(move, blocker_info))
+                    output(move);
+            return;
+        }
+
+        const bitboard_t occupied = occupancy();
+
+        // ̎ނƂɁA̋ړƉɗW
+        bitboard_t check_squares[noncolored_piece_size];
+        search_check_squares(check_squares);
+        bitboard_t targets;
+        for (piece_value_t piece = pawn_value; piece < noncolored_piece_size; ++piece)
+            if (piece != king_value)
+                targets |= check_squares[piece];
+        targets &= ~occupancy(color());
+
+        // JƂȂ͑SĂ̈ړAȊŐ͉ɗWւ̈ړɌĐB
+        search_moves_moves(std::back_inserter(moves), targets, blocker_info.pinned());
+        for (const move_t & move : moves)
+            if (gives_check(move, blocker_info))
+                output(move);
+
+        for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
+        {
+            if (captured_pieces_list[color().value()][piece])
+            {
+                bitboard_t destinations = check_squares[piece] & ~occupied;
+                while (!destinations.empty())
+                {
+                    const position_t destination = destinations.pop();
+                    if (puttable(piece, destination))
+                        *result++ = { destination, piece, move_t::check_tag | move_t::put_tag };
+                }
+            }
+        }
     }
 
     template<typename OutputIterator>
     inline void state_t::search_moves(OutputIterator result) const
     {
-        SHOGIPP_ASSERT(move_count < additional_info.check_list_stack.size());
-        auto & check_list = additional_info.check_list_stack[move_count];
+        SHOGIPP_ASSERT(!additional_info.check_list_stack.empty());
+        auto & check_list = additional_info.check_list_stack.back();
         if (check_list.empty())
             search_moves_nonescapes(result);
         else
@@ -4676,15 +6572,15 @@ namespace shogipp
         hash_t hash{};
 
         // Տ̋̃nbVlXORZ
-        for (position_t position = position_begin; position < position_end; ++position)
-            if (!board_t::out(position))
-                if (const colored_piece_t piece = board[position]; !piece.empty())
-                    hash ^= hash_table.piece_hash(piece, position);
+        bitboard_t sources = occupancy();
+        while (!sources.empty())
+        {
+            const position_t position = sources.pop();
+            hash ^= hash_table.piece_hash(board[position], position);
+        }
 
         // ̃nbVlXORZ
-        for (const color_t color : colors)
-            for (piece_value_t piece = pawn.value(); piece <= rook.value(); ++piece)
-                hash ^= hash_table.captured_piece_hash(captured_piece_t{ piece }, captured_pieces_list[color.value()][captured_piece_t{ piece }], color);
+        hash ^= make_captured_pieces_hash();
 
         // Ԃ̃nbVlXORZ
         hash ^= hash_table.color_hash(color());
@@ -4693,6 +6589,15 @@ namespace shogipp
         return hash;
     }
 
+    inline hash_t state_t::make_captured_pieces_hash() const
+    {
+        hash_t hash{};
+        for (const color_t color : colors)
+            for (piece_value_t piece = pawn.value(); piece <= rook.value(); ++piece)
+                hash ^= hash_table.captured_piece_hash(captured_piece_t{ piece }, captured_pieces_list[color.value()][captured_piece_t{ piece }], color);
+        return hash;
+    }
+
     inline hash_t state_t::make_hash(hash_t hash, const move_t & move) const
     {
         if (move.put())
@@ -4773,8 +6678,8 @@ namespace shogipp
     {
         if (details::program_options::print_check)
         {
-            SHOGIPP_ASSERT(move_count < additional_info.check_list_stack.size());
-            auto & check_list = additional_info.check_list_stack[move_count];
+            SHOGIPP_ASSERT(!additional_info.check_list_stack.empty());
+            auto & check_list = additional_info.check_list_stack.back();
             if (!check_list.empty())
             {
                 ostream << "F";
@@ -4839,8 +6744,8 @@ namespace shogipp
 
     inline hash_t state_t::hash() const
     {
-        SHOGIPP_ASSERT(move_count < additional_info.hash_stack.size());
-        return additional_info.hash_stack[move_count];
+        SHOGIPP_ASSERT(!additional_info.hash_stack.empty());
+        return additional_info.hash_stack.back().hash;
     }
 
     inline void state_t::validate_board_out()
@@ -4856,16 +6761,20 @@ namespace shogipp
         if (move.put())
         {
             SHOGIPP_ASSERT(captured_pieces_list[color().value()][move.captured_piece()] > 0);
-            board[move.destination()] = colored_piece_t{ move.captured_piece(), color() };
+            place_piece(move.destination(), colored_piece_t{ move.captured_piece(), color() });
             --captured_pieces_list[color().value()][move.captured_piece()];
         }
         else
         {
             SHOGIPP_ASSERT(!(!move.source_piece().is_promotable() && move.promote()));
             if (!board[move.destination()].empty())
+            {
                 ++captured_pieces_list[color().value()][captured_piece_t{ board[move.destination()] }];
-            board[move.destination()] = move.promote() ? board[move.source()].to_promoted() : board[move.source()];
-            board[move.source()] = colored_piece_t{};
+                remove_piece(move.destination());
+            }
+            const colored_piece_t source_piece = board[move.source()];
+            remove_piece(move.source());
+            place_piece(move.destination(), move.promote() ? source_piece.to_promoted() : source_piece);
             if (noncolored_piece_t{ move.source_piece() } == king)
                 additional_info.king_position_list[color().value()] = move.destination();
         }
@@ -4884,16 +6793,19 @@ namespace shogipp
         if (move.put())
         {
             ++captured_pieces_list[color().value()][move.captured_piece()];
-            board[move.destination()] = colored_piece_t{};
+            remove_piece(move.destination());
         }
         else
         {
             if (noncolored_piece_t{ move.source_piece() } == king)
                 additional_info.king_position_list[color().value()] = move.source();
-            board[move.source()] = move.source_piece();
-            board[move.destination()] = move.destination_piece();
+            remove_piece(move.destination());
+            place_piece(move.source(), move.source_piece());
             if (!move.destination_piece().empty())
+            {
+                place_piece(move.destination(), move.destination_piece());
                 --captured_pieces_list[color().value()][captured_piece_t{ move.destination_piece() }];
+            }
         }
         kifu.pop_back();
         pop_additional_info();
@@ -4920,8 +6832,14 @@ namespace shogipp
         if (depth == 0)
             return 1;
 
+        const moves_t moves = nonstrict_search_moves();
+
+        // Ō̎萔ł͍@̐ǖʂ̐ɓ߁A@sȂB
+        if (depth == 1)
+            return moves.size();
+
         search_count_t count = 0;
-        for (const move_t & move : search_moves())
+        for (const move_t & move : moves)
         {
             VALIDATE_STATE_ROLLBACK(*this);
             const_cast<state_t &>(*this).do_move(move);
@@ -4931,48 +6849,406 @@ namespace shogipp
         return count;
     }
 
-    inline std::string state_t::sfen_string() const
-    {
-        std::string result;
-        result += initial_sfen_string;
-        result += ' ';
-        result += color_to_color_char(color());
-        result += ' ';
-        result += std::to_string(move_count + 1);
-        if (!kifu.empty())
-        {
-            result += " moves";
-            for (const move_t & move : kifu)
-            {
-                result += ' ';
-                result += move.sfen_string();
-            }
-        }
-        return result;
-    }
-
-    inline void state_t::remove_repetition_of_moves(moves_t & moves) const noexcept
+    /**
+     * @breif perft ̒u\
+     * @details ǖʂ̃nbVlƎc̎萔ǖʂ̐B̃Xbh瓯ɎQƂB
+     *          Gg̓L[Ƌǖʂ̐̔rI_aێAbNpɏ݂GgoB
+     */
+    class perft_table_t
     {
-        const hash_t hash = this->hash();
-        const color_t color = this->color();
-        moves.erase(std::remove_if(moves.begin(), moves.end(), [&](const auto & i) -> bool
-            {
-                return additional_info.previously_done_moves.contains(
-                    hash_table.move_hash(i, color) ^ hash
-                );
-            }
-        ), moves.end());
-    }
+    public:
+        /**
+         * @breif perft ̒u\\zB
+         * @param size u\̑傫[byte]
+         */
+        inline explicit perft_table_t(std::size_t size);
 
-    inline position_t state_t::king_position(color_t color) const noexcept
-    {
-        return additional_info.king_position_list[color.value()];
-    }
+        /**
+         * @breif ǖʂ̐擾B
+         * @param hash ǖʂ̃nbVl
+         * @param depth c̎萔
+         * @return ǖʂ̐(u\ɑ݂Ȃꍇ std::nullopt)
+         */
+        inline std::optional<search_count_t> get(const hash_t & hash, move_count_t depth) const noexcept;
 
-    inline const std::vector<kiki_t> & state_t::check_list() const noexcept
+        /**
+         * @breif ǖʂ̐o^B
+         * @param hash ǖʂ̃nbVl
+         * @param depth c̎萔
+         * @param count ǖʂ̐
+         */
+        inline void push(const hash_t & hash, move_count_t depth, search_count_t count) noexcept;
+
+    private:
+        class entry_t
+        {
+        public:
+            std::atomic<std::uint64_t> check{};   // L[Ƌǖʂ̐̔rI_a
+            std::atomic<std::uint64_t> count{};   // ǖʂ̐
+        };
+
+        /**
+         * @breif ǖʂ̃nbVlƎc̎萔L[vZB
+         */
+        inline static std::uint64_t key(const hash_t & hash, move_count_t depth) noexcept;
+
+        std::unique_ptr<entry_t[]> m_entries;
+        std::size_t m_mask;
+    };
+
+    inline perft_table_t::perft_table_t(std::size_t size)
+    {
+        std::size_t entry_size = 1;
+        while (entry_size * 2 * sizeof(entry_t) <= size)
+            entry_size *= 2;
+        m_entries = std::make_unique<entry_t[]>(entry_size);
+        m_mask = entry_size - 1;
+    }
+
+    inline std::optional<search_count_t> perft_table_t::get(const hash_t & hash, move_count_t depth) const noexcept
+    {
+        const std::uint64_t key = this->key(hash, depth);
+        const entry_t & entry = m_entries[static_cast<std::size_t>(key) & m_mask];
+        const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        const std::uint64_t count = entry.count.load(std::memory_order_relaxed);
+        if ((check ^ count) != key)
+            return std::nullopt;
+        return static_cast<search_count_t>(count);
+    }
+
+    inline void perft_table_t::push(const hash_t & hash, move_count_t depth, search_count_t count) noexcept
+    {
+        const std::uint64_t key = this->key(hash, depth);
+        entry_t & entry = m_entries[static_cast<std::size_t>(key) & m_mask];
+        entry.check.store(key ^ count, std::memory_order_relaxed);
+        entry.count.store(count, std::memory_order_relaxed);
+    }
+
+    inline std::uint64_t perft_table_t::key(const hash_t & hash, move_count_t depth) noexcept
+    {
+        return static_cast<std::uint64_t>(static_cast<std::size_t>(hash)) ^ (static_cast<std::uint64_t>(depth) * 0x9E3779B97F4A7C15ull);
+    }
+
+    namespace details
+    {
+        /**
+         * @breif w肳ꂽ萔ŕ򂷂ǖʂ̐u\pĐB
+         * @param state ǖ
+         * @param depth 萔
+         * @param table perft ̒u\
+         * @return ǖʂ̐
+         * @details OȂB
+         */
+        inline search_count_t perft(state_t & state, move_count_t depth, perft_table_t & table)
+        {
+            if (depth == 0)
+                return 1;
+
+            if (depth > 1)
+                if (const std::optional<search_count_t> count = table.get(state.hash(), depth))
+                    return *count;
+
+            const moves_t moves = state.nonstrict_search_moves();
+            if (depth == 1)
+                return moves.size();
+
+            search_count_t count = 0;
+            for (const move_t & move : moves)
+            {
+                VALIDATE_STATE_ROLLBACK(state);
+                state.do_move(move);
+                count += perft(state, depth - 1, table);
+                state.undo_move();
+            }
+            table.push(state.hash(), depth, count);
+            return count;
+        }
+    }
+
+    /**
+     * @breif w肳ꂽ萔ŕ򂷂ǖʂ̐𐔂A[gǖʂ̍@育Ƃ̋ǖʂ̐o͂B
+     * @param state ǖ
+     * @param depth 萔
+     * @param thread_number Xbh
+     * @param table_size u\̑傫[byte]
+     * @param ostream o̓Xg[
+     * @return ǖʂ̐
+     * @details [gǖʂ̍@XbhɕzASẴXbhŒu\LBOȂB
+     */
+    inline search_count_t perft(const state_t & state, move_count_t depth, unsigned int thread_number, std::size_t table_size, std::ostream & ostream = std::cout)
+    {
+        const std::chrono::system_clock::time_point begin = std::chrono::system_clock::now();
+
+        search_count_t total = 1;
+        if (depth > 0)
+        {
+            const moves_t moves = state.nonstrict_search_moves();
+            std::vector<search_count_t> counts(moves.size());
+            perft_table_t table{ table_size };
+            std::atomic<std::size_t> next_index{ 0 };
+            const state_snapshot_t snapshot = state.snapshot();
+
+            std::vector<std::future<void>> futures;
+            for (unsigned int thread_id = 0; thread_id < std::max(thread_number, 1u); ++thread_id)
+            {
+                futures.push_back(std::async(std::launch::async, [&]
+                    {
+                        state_t temp{ snapshot };
+                        for (std::size_t index = next_index++; index < moves.size(); index = next_index++)
+                        {
+                            VALIDATE_STATE_ROLLBACK(temp);
+                            temp.do_move(moves[index]);
+                            counts[index] = details::perft(temp, depth - 1, table);
+                            temp.undo_move();
+                        }
+                    }));
+            }
+            for (std::future<void> & future : futures)
+                future.get();
+
+            total = 0;
+            for (std::size_t index = 0; index < moves.size(); ++index)
+            {
+                ostream << moves[index].sfen_string() << ": " << counts[index] << std::endl;
+                total += counts[index];
+            }
+        }
+
+        const std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
+        const std::chrono::milliseconds::rep duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+        const search_count_t nps = duration != 0 ? total * 1000 / duration : 0;
+        ostream
+            << std::endl
+            << "ǖʐ          F" << total << std::endl
+            << "s        F" << duration << "[ms]" << std::endl
+            << "ǖʑx        F" << nps << "[n/s]" << std::endl;
+        return total;
+    }
+
+    /**
+     * @breif ׂɎwi߂ǖʂŁǍʂ؂B
+     * @param state Jnǖ
+     * @param position_number ؂ǖʂ̐
+     * @param ostream o̓Xg[
+     * @return ʂvȂǖʂ̐
+     * @details state_t::search_checks ̌ʂAOȂSĂ̍@̂ۂɎwĉƂȂƔrB
+     *          l݂܂͈̎萔ɒBꍇ͊Jnǖʂ蒼B
+     */
+    inline search_count_t verify_checks(const state_t & state, search_count_t position_number, std::ostream & ostream = std::cout)
+    {
+        constexpr move_count_t max_move_count = 256;
+        const state_snapshot_t snapshot = state.snapshot();
+        state_t temp{ snapshot };
+        move_count_t move_count = 0;
+        search_count_t position_count = 0;
+        search_count_t mismatch_count = 0;
+
+        while (position_count < position_number)
+        {
+            const moves_t moves = temp.nonstrict_search_moves();
+            if (moves.empty() || move_count >= max_move_count)
+            {
+                temp = state_t{ snapshot };
+                move_count = 0;
+                continue;
+            }
+
+            std::vector<std::string> expected;
+            for (const move_t & move : moves)
+            {
+                VALIDATE_STATE_ROLLBACK(temp);
+                temp.do_move(move);
+                if (!temp.check_list().empty())
+                    expected.push_back(move.sfen_string());
+                temp.undo_move();
+            }
+
+            moves_t checks;
+            temp.search_checks(std::back_inserter(checks));
+            std::vector<std::string> actual;
+            for (const move_t & move : checks)
+                actual.push_back(move.sfen_string());
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            if (expected != actual)
+            {
+                ++mismatch_count;
+                ostream << "mismatch: " << temp.sfen_string() << std::endl;
+            }
+
+            temp.do_move(moves[details::random<std::size_t>(0, static_cast<int>(moves.size() - 1))]);
+            ++move_count;
+            ++position_count;
+        }
+
+        ostream
+            << std::endl
+            << "؋ǖʐ      F" << position_number << std::endl
+            << "svǖʐ    F" << mismatch_count << std::endl;
+        return mismatch_count;
+    }
+
+    inline std::string state_t::sfen_string() const
+    {
+        std::string result;
+        result += initial_sfen_string;
+        result += ' ';
+        result += color_to_color_char(color());
+        result += ' ';
+        result += std::to_string(move_count + 1);
+        if (!kifu.empty())
+        {
+            result += " moves";
+            for (const move_t & move : kifu)
+            {
+                result += ' ';
+                result += move.sfen_string();
+            }
+        }
+        return result;
+    }
+
+    inline void state_t::remove_repetition_of_moves(moves_t & moves) const
+    {
+        moves.erase(std::remove_if(moves.begin(), moves.end(), [&](const move_t & move) -> bool
+            {
+                return is_repetition_move(move);
+            }
+        ), moves.end());
+    }
+
+    inline bool state_t::is_repetition_move(const move_t & move) const
+    {
+        // @{̋ǖʂ1ŐǖʂƎԂłA2肸kB
+        const hash_t hash = make_hash(this->hash(), move);
+        const std::vector<repetition_info_t> & hash_stack = additional_info.hash_stack;
+        std::size_t distance = 2;
+        for (; distance <= hash_stack.size(); distance += 2)
+            if (hash_stack[hash_stack.size() - distance].hash == hash)
+                return true;
+        if (const auto & root_hash_stack = additional_info.root_hash_stack)
+            for (distance -= hash_stack.size(); distance <= root_hash_stack->size(); distance += 2)
+                if ((*root_hash_stack)[root_hash_stack->size() - distance].hash == hash)
+                    return true;
+        return false;
+    }
+
+    inline repetition_state_t state_t::repetition_state() const noexcept
+    {
+        const std::vector<repetition_info_t> & hash_stack = additional_info.hash_stack;
+        SHOGIPP_ASSERT(!hash_stack.empty());
+        const repetition_info_t & current = hash_stack.back();
+        const captured_pieces_t & captured_pieces = current.captured_pieces;
+
+        // ē̋ǖʂߋɌĂȂ΁A𑖍ȂB
+        // Ă΁ȂSĂ_őIB
+        std::size_t remaining_size = additional_info.board_hash_table.count(current.board_hash) - 1;
+        if (remaining_size == 0)
+            return repetition_state_t::none;
+
+        bool checked = current.check;   // ԂꑱĂ
+        bool checking = true;           // ԂĂ
+        const std::vector<repetition_info_t> * stack = &hash_stack;
+        std::size_t index = hash_stack.size() - 1;
+        for (std::size_t distance = 1; ; ++distance)
+        {
+            if (index == 0)
+            {
+                if (stack != &hash_stack || !additional_info.root_hash_stack || additional_info.root_hash_stack->empty())
+                    break;
+                stack = additional_info.root_hash_stack.get();
+                index = stack->size();
+            }
+            const repetition_info_t & previous = (*stack)[--index];
+            const bool found = previous.board_hash == current.board_hash;
+            if (found)
+                --remaining_size;
+
+            // ̎Ԃ̋ǖ
+            if (distance % 2 == 1)
+            {
+                checking = checking && previous.check;
+                if (remaining_size == 0)
+                    break;
+                continue;
+            }
+
+            checked = checked && previous.check;
+            if (found)
+            {
+                bool superior = true, inferior = true;
+                for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
+                {
+                    superior = superior && captured_pieces[piece] >= previous.captured_pieces[piece];
+                    inferior = inferior && captured_pieces[piece] <= previous.captured_pieces[piece];
+                }
+                if (superior && inferior)
+                {
+                    if (checked)
+                        return repetition_state_t::win;
+                    if (checking)
+                        return repetition_state_t::lose;
+                    return repetition_state_t::draw;
+                }
+                if (superior)
+                    return repetition_state_t::superior;
+                if (inferior)
+                    return repetition_state_t::inferior;
+            }
+            if (remaining_size == 0)
+                break;
+        }
+        return repetition_state_t::none;
+    }
+
+    inline bool state_t::is_legal(const move_t & move) const
+    {
+        if (!check_list().empty())
+        {
+            moves_t moves;
+            search_moves_escapes(std::back_inserter(moves));
+            return std::find(moves.begin(), moves.end(), move) != moves.end();
+        }
+
+        if (move.put())
+            return !board_t::out(move.destination())
+                && captured_pieces_list[color().value()][move.captured_piece()] > 0
+                && puttable(move.captured_piece(), move.destination());
+
+        const position_t source = move.source();
+        const position_t destination = move.destination();
+        if (board_t::out(source) || board_t::out(destination))
+            return false;
+        if (board[source].empty() || board[source] != move.source_piece() || board[source].to_color() != color())
+            return false;
+        if (board[destination] != move.destination_piece())
+            return false;
+
+        bitboard_t destinations = destination_bitboard(source, color());
+        const aigoma_info_t aigoma_info = search_aigoma(color());
+        if (const bitboard_t * candidates = aigoma_info.find(source))
+            destinations &= *candidates;
+        if (!destinations.test(destination))
+            return false;
+
+        if (noncolored_piece_t{ board[source] } == king && is_attacked(destination, !color()))
+            return false;
+
+        if (move.promote())
+            return promotable(board[source], source, destination);
+        return !must_promote(board[source], destination);
+    }
+
+    inline position_t state_t::king_position(color_t color) const noexcept
     {
-        SHOGIPP_ASSERT(move_count < additional_info.check_list_stack.size());
-        return additional_info.check_list_stack[move_count];
+        return additional_info.king_position_list[color.value()];
+    }
+
+    inline const check_list_t & state_t::check_list() const noexcept
+    {
+        SHOGIPP_ASSERT(!additional_info.check_list_stack.empty());
+        return additional_info.check_list_stack.back();
     }
 
     inline void state_t::add_observer(const std::shared_ptr<observer_t> & observer)
@@ -5242,141 +7518,380 @@ namespace shogipp
         state_t m_state;
     };
 
-    template<typename Key, typename Value, typename Hash = std::hash<Key>>
-    class lru_cache_t
+    /**
+     * @breif u\̕]l̎
+     */
+    enum class bound_t : unsigned char
     {
-    public:
-        using key_type = Key;
-        using value_type = Value;
-        using pair_type = std::pair<key_type, value_type>;
-        using list_type = std::list<pair_type>;
-        using hash_type = Hash;
-        using unordered_map_type = std::unordered_map<key_type, typename list_type::iterator, hash_type>;
+        none,   // ]lȂ
+        exact,  // mȕ]l
+        lower,  // ]l̉(beta Jbg)
+        upper   // ]l̏(alpha 𒴂肪Ȃ)
+    };
 
+    class cache_value_t
+    {
+    public:
         /**
-         * @breif LRUŊǗLbV\zB
-         * @param capacity ővf
+         * @breif Tɑ΂]l̎ނ擾B
+         * @param evaluation_value ]l
+         * @param alpha TJn_ alpha
+         * @param beta beta
+         * @return ]l̎
          */
-        inline lru_cache_t(std::size_t capacity)
-            : capacity{ capacity }
+        inline static bound_t make_bound(evaluation_value_t evaluation_value, evaluation_value_t alpha, evaluation_value_t beta) noexcept
         {
+            if (evaluation_value <= alpha)
+                return bound_t::upper;
+            if (evaluation_value >= beta)
+                return bound_t::lower;
+            return bound_t::exact;
         }
 
-        inline lru_cache_t(const lru_cache_t &) = default;
-        inline lru_cache_t(lru_cache_t &&) = default;
-        inline lru_cache_t & operator =(const lru_cache_t &) = default;
-        inline lru_cache_t & operator =(lru_cache_t &&) = default;
-
         /**
-         * @breif LbVjB
+         * @breif u\̕]lŒTł؂邩肷B
+         * @param draft c̒T[
+         * @param alpha alpha
+         * @param beta beta
+         * @retval true ł؂
+         * @retval false ł؂Ȃ
          */
-        inline void clear()
+        inline bool cutoff(depth_t draft, evaluation_value_t alpha, evaluation_value_t beta) const noexcept
         {
-            list.clear();
-            umap.clear();
+            if (this->draft < draft)
+                return false;
+            return bound == bound_t::exact
+                || (bound == bound_t::lower && evaluation_value >= beta)
+                || (bound == bound_t::upper && evaluation_value <= alpha);
         }
 
+        evaluation_value_t evaluation_value{};
+        depth_t draft{};                        // ]l𓾂T̎c̐[
+        bound_t bound = bound_t::none;
+        std::optional<move_t> best_move;
+    };
+
+    /**
+     * @breif u\
+     * @details 傫Œ肳ꂽoPbg̔zŁASĂ̒TXbh瓯ɎQƂB
+     *          Gg̓L[ƒl̔rI_aێAbNpɏ݂GgoB
+     *          ΋ǂʂēu\gpATƂɐi߂BȑO̐̃Gg͎QƂł邪AD悵ď㏑B
+     */
+    class transposition_table_t
+    {
+    public:
+        /**
+         * @breif 1̃oPbgɊi[Gg̐
+         * @details oPbgLbVC2{Ɏ܂ő̐ƂB
+         */
+        constexpr static std::size_t bucket_size = 5;
+
+        /**
+         * @breif u\\zB
+         * @param size u\̑傫[byte]
+         */
+        inline explicit transposition_table_t(std::size_t size);
+
+        /**
+         * @breif u\̑傫擾B
+         * @return \zɎw肳ꂽu\̑傫[byte]
+         */
+        inline std::size_t size() const noexcept;
+
+        /**
+         * @breif u\jB
+         */
+        inline void clear() noexcept;
+
+        /**
+         * @breif i߂B
+         * @details TJnOɌĂяoB
+         */
+        inline void new_search() noexcept;
+
         /**
          * @breif L[ƑΉl擾B
-         * @param key L[
-         * @return L[ƑΉl
+         * @param hash ǖʂ̃nbVl
+         * @return L[ƑΉl(u\ɑ݂Ȃꍇ std::nullopt)
          */
-        inline std::optional<Value> get(key_type key)
-        {
-            typename unordered_map_type::iterator iter = umap.find(key);
-            if (iter == umap.end())
-                return std::nullopt;
-            value_type value = iter->second->second;
-            list.erase(iter->second);
-            list.emplace_front(key, value);
-            umap[key] = list.begin();
-            return value;
-        }
+        inline std::optional<cache_value_t> get(const hash_t & hash) const noexcept;
 
         /**
          * @breif L[ƒlo^B
-         * @param key L[
+         * @param hash ǖʂ̃nbVl
          * @param value l
+         * @details ǖʂ̃Gg΂AȂ΃oPbgňȑO̐̃Gĝłc̐[󂢃GgA
+         *          ȑO̐̃GgȂ΍łc̐[󂢃Gg㏑B
+         *          ǖʂ̃Gg݂̐ł[T̒lێĂꍇA㏑ȂB
          */
-        inline void push(key_type key, value_type value)
-        {
-            typename unordered_map_type::iterator iter = umap.find(key);
-            if (iter != umap.end())
-                list.erase(iter->second);
-            list.emplace_front(key, value);
-            umap[key] = list.begin();
-            if (list.size() > capacity)
-            {
-                umap.erase(list.rbegin()->first);
-                list.pop_back();
-            }
-        }
-
-    private:
-        list_type list;
-        unordered_map_type umap;
-        std::size_t capacity;
-    };
+        inline void push(const hash_t & hash, const cache_value_t & value) noexcept;
 
-    class cache_value_t
-    {
-    public:
-        evaluation_value_t evaluation_value{};
-        iddfs_iteration_t max_iddfs_iteration{};
-        bool is_best_move{};
-    };
+        /**
+         * @breif ̒u\̑SẴGgo^B
+         * @param other ̒u\
+         * @details Gg push ƓKœo^B
+         */
+        inline void merge(const transposition_table_t & other) noexcept;
 
-#ifdef SIZE_OF_HASH
-    using cache_t = lru_cache_t<hash_t, cache_value_t, basic_hash_hasher_t<SIZE_OF_HASH>>;
-#else
-    using cache_t = lru_cache_t<hash_t, cache_value_t>;
-#endif
+    private:
+        using verification_t = std::uint16_t;
+        using generation_t = std::uint8_t;
 
-    /**
-     * @breif Ղ2̑gƑΉ]l̓v
-     */
-    class piece_relationship_statistics_t
-    {
-    public:
-        using value_type = unsigned long long;
-        constexpr static std::size_t piece_category_size = (piece_size / 2) * piece_size;
-        constexpr static std::size_t relative_position9x9_size = file_size * rank_size - 1;
+        class entry_t
+        {
+        public:
+            std::atomic<std::uint64_t> check{};   // L[ƒl̔rI_a
+            std::atomic<std::uint64_t> data{};    // ؒlAc̐[A]l
+            std::atomic<std::uint64_t> move{};    // A]l̎ށAőP
+        };
 
-        class element_t
+        // oPbgLbVC̋EɑÃoPbgƃLbVCLȂ悤ɂB
+        class alignas(64) bucket_t
         {
         public:
-            colored_piece_t piece1{};
-            colored_piece_t piece2{};
-            position_t relative_position{};
-            value_type value{};
+            entry_t entries[bucket_size];
         };
+        static_assert(sizeof(bucket_t) == 128);
 
         /**
-         * @breif Ղ2̑gƑΉ]l̓v\zB
-         * @details SĂ̕]l 0 ŏB
+         * @breif L[ƌؒlɑΉlo^B
          */
-        constexpr inline piece_relationship_statistics_t() noexcept = default;
-        constexpr inline piece_relationship_statistics_t(const piece_relationship_statistics_t &) noexcept = default;
-        constexpr inline piece_relationship_statistics_t(piece_relationship_statistics_t &&) noexcept = default;
-        constexpr inline piece_relationship_statistics_t & operator =(const piece_relationship_statistics_t &) noexcept = default;
-        constexpr inline piece_relationship_statistics_t & operator =(piece_relationship_statistics_t &&) noexcept = default;
+        inline void push(std::uint64_t key, verification_t verification, const cache_value_t & value) noexcept;
 
         /**
-         * @breif ƍW̑g𐳋KB
-         *        W2 >= W1 𖞂悤ɑgւB
-         *        ΓIȋ؂͏ɐ̒lɕϊB΁Å֐͈ʒu֌WEΏ̂ɈB
-         *        ܂A1Ƌ2̊֌W(ԂłA邢͈)ێ܂܋1̋ɕϊB
-         * @param piece1 1
-         * @param position1 W1
-         * @param piece2 2
-         * @param position2 W2
-         * @return ёւ̍W1Ƃ1-81̑΍W
+         * @breif ؒlAc̐[A]l1[hɋl߂B
          */
-        inline static position_t canonicalize(colored_piece_t & piece1, position_t & position1, colored_piece_t & piece2, position_t & position2)
-        {
-            SHOGIPP_ASSERT(position1 != position2);
+        inline static std::uint64_t pack_data(verification_t verification, const cache_value_t & value) noexcept;
 
-            if (position1 > position2)
+        /**
+         * @breif A]l̎ނƍőP1[hɋl߂B
+         */
+        inline static std::uint64_t pack_move(generation_t generation, const cache_value_t & value) noexcept;
+
+        /**
+         * @breif pack_data ŋl߂[h猟ؒloB
+         */
+        inline static verification_t unpack_verification(std::uint64_t data) noexcept;
+
+        /**
+         * @breif pack_data ŋl߂[hc̐[oB
+         */
+        inline static depth_t unpack_draft(std::uint64_t data) noexcept;
+
+        /**
+         * @breif pack_move ŋl߂[h琢oB
+         */
+        inline static generation_t unpack_generation(std::uint64_t move) noexcept;
+
+        /**
+         * @breif pack_data  pack_move ŋl߂[hloB
+         */
+        inline static cache_value_t unpack_value(std::uint64_t data, std::uint64_t move) noexcept;
+
+        std::unique_ptr<bucket_t[]> m_buckets;
+        std::size_t m_mask;
+        std::size_t m_size;
+        std::atomic<generation_t> m_generation{};
+    };
+
+    inline transposition_table_t::transposition_table_t(std::size_t size)
+        : m_size{ size }
+    {
+        std::size_t bucket_count = 1;
+        while (bucket_count * 2 * sizeof(bucket_t) <= size)
+            bucket_count *= 2;
+        m_buckets = std::make_unique<bucket_t[]>(bucket_count);
+        m_mask = bucket_count - 1;
+    }
+
+    inline std::size_t transposition_table_t::size() const noexcept
+    {
+        return m_size;
+    }
+
+    inline void transposition_table_t::new_search() noexcept
+    {
+        m_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void transposition_table_t::clear() noexcept
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            for (entry_t & entry : m_buckets[i].entries)
+            {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+                entry.move.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline std::optional<cache_value_t> transposition_table_t::get(const hash_t & hash) const noexcept
+    {
+        const std::uint64_t key = hash.key();
+        const verification_t verification = hash.verification<verification_t>();
+        const bucket_t & bucket = m_buckets[static_cast<std::size_t>(key) & m_mask];
+        for (const entry_t & entry : bucket.entries)
+        {
+            const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            if (unpack_verification(data) != verification)
+                continue;
+            const std::uint64_t move = entry.move.load(std::memory_order_relaxed);
+            const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+            if ((check ^ data ^ move) == key)
+                return unpack_value(data, move);
+        }
+        return std::nullopt;
+    }
+
+    inline void transposition_table_t::push(const hash_t & hash, const cache_value_t & value) noexcept
+    {
+        push(hash.key(), hash.verification<verification_t>(), value);
+    }
+
+    inline void transposition_table_t::merge(const transposition_table_t & other) noexcept
+    {
+        for (std::size_t i = 0; i <= other.m_mask; ++i)
+        {
+            for (const entry_t & entry : other.m_buckets[i].entries)
+            {
+                const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+                const std::uint64_t move = entry.move.load(std::memory_order_relaxed);
+                const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+                if (check == 0 && data == 0 && move == 0)
+                    continue;
+                push(check ^ data ^ move, unpack_verification(data), unpack_value(data, move));
+            }
+        }
+    }
+
+    inline void transposition_table_t::push(std::uint64_t key, verification_t verification, const cache_value_t & value) noexcept
+    {
+        const generation_t generation = m_generation.load(std::memory_order_relaxed);
+        bucket_t & bucket = m_buckets[static_cast<std::size_t>(key) & m_mask];
+        entry_t * replace = nullptr;
+        bool replace_current = true;
+        depth_t min_draft = std::numeric_limits<depth_t>::max();
+        for (entry_t & entry : bucket.entries)
+        {
+            const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            const std::uint64_t move = entry.move.load(std::memory_order_relaxed);
+            const depth_t draft = unpack_draft(data);
+            if (unpack_verification(data) == verification
+                && (entry.check.load(std::memory_order_relaxed) ^ data ^ move) == key)
+            {
+                // ȑO̐̃Gg͎c̐[ɂ炸㏑B
+                if (draft > value.draft && unpack_generation(move) == generation)
+                    return;
+                replace = &entry;
+                break;
+            }
+            const bool current = unpack_generation(move) == generation;
+            if ((replace_current && !current) || (replace_current == current && draft < min_draft))
+            {
+                replace = &entry;
+                replace_current = current;
+                min_draft = draft;
+            }
+        }
+        const std::uint64_t data = pack_data(verification, value);
+        const std::uint64_t move = pack_move(generation, value);
+        replace->check.store(key ^ data ^ move, std::memory_order_relaxed);
+        replace->data.store(data, std::memory_order_relaxed);
+        replace->move.store(move, std::memory_order_relaxed);
+    }
+
+    inline std::uint64_t transposition_table_t::pack_data(verification_t verification, const cache_value_t & value) noexcept
+    {
+        // c̐[16rbgɎ܂ȂꍇAOaB
+        std::uint64_t data = verification;
+        data = (data << 16) | static_cast<std::uint16_t>(std::min<depth_t>(value.draft, std::numeric_limits<std::uint16_t>::max()));
+        data = (data << 32) | static_cast<std::uint32_t>(value.evaluation_value);
+        return data;
+    }
+
+    inline std::uint64_t transposition_table_t::pack_move(generation_t generation, const cache_value_t & value) noexcept
+    {
+        std::uint64_t move = (static_cast<std::uint64_t>(generation) << 3) | (static_cast<std::uint64_t>(value.bound) << 1);
+        if (value.best_move)
+            move = ((move | 1) << 32) | value.best_move->value();
+        else
+            move <<= 32;
+        return move;
+    }
+
+    inline transposition_table_t::verification_t transposition_table_t::unpack_verification(std::uint64_t data) noexcept
+    {
+        return static_cast<verification_t>(data >> 48);
+    }
+
+    inline depth_t transposition_table_t::unpack_draft(std::uint64_t data) noexcept
+    {
+        return static_cast<depth_t>((data >> 32) & 0xFFFF);
+    }
+
+    inline transposition_table_t::generation_t transposition_table_t::unpack_generation(std::uint64_t move) noexcept
+    {
+        return static_cast<generation_t>(move >> 35);
+    }
+
+    inline cache_value_t transposition_table_t::unpack_value(std::uint64_t data, std::uint64_t move) noexcept
+    {
+        cache_value_t value;
+        value.evaluation_value = static_cast<evaluation_value_t>(static_cast<std::int32_t>(data & 0xFFFF'FFFF));
+        value.draft = unpack_draft(data);
+        value.bound = static_cast<bound_t>((move >> 33) & 0x3);
+        if ((move >> 32) & 1)
+            value.best_move = move_t::from_value(static_cast<move_t::value_type>(move & 0xFFFF'FFFF));
+        return value;
+    }
+
+    /**
+     * @breif Ղ2̑gƑΉ]l̓v
+     */
+    class piece_relationship_statistics_t
+    {
+    public:
+        using value_type = unsigned long long;
+        constexpr static std::size_t piece_category_size = (piece_size / 2) * piece_size;
+        constexpr static std::size_t relative_position9x9_size = file_size * rank_size - 1;
+
+        class element_t
+        {
+        public:
+            colored_piece_t piece1{};
+            colored_piece_t piece2{};
+            position_t relative_position{};
+            value_type value{};
+        };
+
+        /**
+         * @breif Ղ2̑gƑΉ]l̓v\zB
+         * @details SĂ̕]l 0 ŏB
+         */
+        constexpr inline piece_relationship_statistics_t() noexcept = default;
+        constexpr inline piece_relationship_statistics_t(const piece_relationship_statistics_t &) noexcept = default;
+        constexpr inline piece_relationship_statistics_t(piece_relationship_statistics_t &&) noexcept = default;
+        constexpr inline piece_relationship_statistics_t & operator =(const piece_relationship_statistics_t &) noexcept = default;
+        constexpr inline piece_relationship_statistics_t & operator =(piece_relationship_statistics_t &&) noexcept = default;
+
+        /**
+         * @breif ƍW̑g𐳋KB
+         *        W2 >= W1 𖞂悤ɑgւB
+         *        ΓIȋ؂͏ɐ̒lɕϊB΁Å֐͈ʒu֌WEΏ̂ɈB
+         *        ܂A1Ƌ2̊֌W(ԂłA邢͈)ێ܂܋1̋ɕϊB
+         * @param piece1 1
+         * @param position1 W1
+         * @param piece2 2
+         * @param position2 W2
+         * @return ёւ̍W1Ƃ1-81̑΍W
+         */
+        inline static position_t canonicalize(colored_piece_t & piece1, position_t & position1, colored_piece_t & piece2, position_t & position2)
+        {
+            SHOGIPP_ASSERT(position1 != position2);
+
+            if (position1 > position2)
             {
                 std::swap(piece1, piece2);
                 std::swap(position1, position2);
@@ -5709,13 +8224,20 @@ namespace shogipp
         inline iddfs_context_t(
             iddfs_iteration_t max_iddfs_iteration,
             std::chrono::milliseconds limit_time,
-            std::size_t cache_capacity,
-            const std::shared_ptr<abstract_evaluator_t> & evaluator
-        ) noexcept
+            const std::shared_ptr<transposition_table_t> & transposition_table,
+            const std::shared_ptr<abstract_evaluator_t> & evaluator,
+            unsigned int thread_number = 1,
+            parallel_mode_t parallel_mode = parallel_mode_t::lazy_smp,
+            bool principal_variation_search = false
+        )
             : m_max_iddfs_iteration{ max_iddfs_iteration }
             , m_limit_time{ limit_time }
-            , m_cache{ cache_capacity }
+            , m_transposition_table{ transposition_table }
             , m_evaluator{ evaluator }
+            , m_thread_number{ thread_number }
+            , m_parallel_mode{ parallel_mode }
+            , m_principal_variation_search{ principal_variation_search }
+            , m_stop{ std::make_shared<std::atomic<bool>>(false) }
         {
         }
 
@@ -5736,18 +8258,20 @@ namespace shogipp
 
         inline bool timeout() const noexcept
         {
+            if (m_stop->load(std::memory_order_relaxed))
+                return true;
             const std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
             return std::chrono::duration_cast<std::chrono::milliseconds>(end - m_begin) >= std::chrono::milliseconds{ m_limit_time };
         }
 
-        inline cache_t & cache() noexcept
-        {
-            return m_cache;
-        }
-
-        inline const cache_t & cache() const noexcept
+        /**
+         * @breif u\擾B
+         * @return u\
+         * @details iddfs_context_t ͓̕u\LBu\͌ĂяoLA΋ǂʂčėpB
+         */
+        inline transposition_table_t & transposition_table() const noexcept
         {
-            return m_cache;
+            return *m_transposition_table;
         }
 
         inline std::shared_ptr<abstract_evaluator_t> & evaluator() noexcept
@@ -5760,12 +8284,53 @@ namespace shogipp
             return m_evaluator;
         }
 
+        /**
+         * @breif TXbh̐擾B
+         * @return TXbh̐
+         */
+        inline unsigned int thread_number() const noexcept
+        {
+            return m_thread_number;
+        }
+
+        /**
+         * @breif ̃XbhɂT̕擾B
+         * @return ̃XbhɂT̕
+         */
+        inline parallel_mode_t parallel_mode() const noexcept
+        {
+            return m_parallel_mode;
+        }
+
+        /**
+         * @breif PVS (Principal Variation Search) ŒT邩肷B
+         * @retval true ZȊO̎qߓ_ null window ŒT
+         * @retval false SĂ̎qߓ_ (alpha, beta) ̑ŒT
+         */
+        inline bool principal_variation_search() const noexcept
+        {
+            return m_principal_variation_search;
+        }
+
+        /**
+         * @breif T̒~vB
+         * @details iddfs_context_t ͒̕~̗vLBvȍ~ timeout  true ԂB
+         */
+        inline void request_stop() noexcept
+        {
+            m_stop->store(true, std::memory_order_relaxed);
+        }
+
     private:
         iddfs_iteration_t m_max_iddfs_iteration{};
         std::chrono::milliseconds m_limit_time{};
         std::chrono::system_clock::time_point m_begin;
-        cache_t m_cache;
+        std::shared_ptr<transposition_table_t> m_transposition_table;
         std::shared_ptr<abstract_evaluator_t> m_evaluator;
+        unsigned int m_thread_number{};
+        parallel_mode_t m_parallel_mode{};
+        bool m_principal_variation_search{};
+        std::shared_ptr<std::atomic<bool>> m_stop;
     };
 
     /**
@@ -5818,6 +8383,27 @@ namespace shogipp
          * @param state ꎞIuWFNg̋ǖ
          */
         virtual void add_observers(state_t & state) {}
+
+        /**
+         * @breif ⏕XbhŒT邽߂̕]֐IuWFNg𕡐B
+         * @return ꂽ]֐IuWFNg(̃XbhɂTɑΉȂꍇ nullptr)
+         * @details  usi_info LȂB
+         */
+        virtual std::shared_ptr<abstract_evaluator_t> clone() const { return nullptr; }
+
+        /**
+         * @breif [[DT Lazy SMP ̕⏕Xbhgp邩肷B
+         * @retval true gp
+         * @retval false gpȂ(u\ɂ}sȂTł́A⏕Xbh͒TZkȂB)
+         */
+        virtual bool supports_lazy_smp() const { return true; }
+
+        /**
+         * @breif YBWC ŌZߓ_XbhԂŕSł邩肷B
+         * @retval true Sł
+         * @retval false SłȂ(YBWC w肳ꂽꍇ Lazy SMP ̕⏕XbhgpB)
+         */
+        virtual bool supports_ybwc() const { return false; }
     };
 
     move_t abstract_evaluator_t::best_move(state_t & state, iddfs_context_t & context)
@@ -5826,7 +8412,7 @@ namespace shogipp
 
         try
         {
-            state_t duplicated{ state };
+            state_t duplicated{ state.snapshot() };
             context.evaluator()->add_observers(duplicated);
             opt_best_move = query_best_move(duplicated, context, 0);
         }
@@ -5853,11 +8439,44 @@ namespace shogipp
     {
         std::optional<move_t> opt_best_move;
         iddfs_iteration_t last_iddfs_iteration = 0;
+        const state_snapshot_t snapshot = state.snapshot();
+        context.transposition_table().new_search();
+
+        // Lazy SMP: ⏕Xbh͒u\LēǖʂTB
+        // TdȂ悤AԖڂ̕⏕Xbh1[JnB⏕Xbh̍őP͍̗pȂB
+        // YBWC w肳ĂZߓ_𕪒SłȂTł́AP̃XbhŒTȂ悤 Lazy SMP gpB
+        std::vector<std::thread> helper_threads;
+        const bool lazy_smp = context.parallel_mode() == parallel_mode_t::lazy_smp || !supports_ybwc();
+        for (unsigned int i = 1; lazy_smp && supports_lazy_smp() && i < context.thread_number(); ++i)
+        {
+            const std::shared_ptr<abstract_evaluator_t> helper_evaluator = clone();
+            if (!helper_evaluator)
+                break;
+            iddfs_context_t helper_context{ context };
+            helper_context.evaluator() = helper_evaluator;
+            helper_threads.emplace_back([snapshot, helper_context, first_iddfs_iteration = static_cast<iddfs_iteration_t>(i % 2)]() mutable
+            {
+                try
+                {
+                    for (iddfs_iteration_t iddf_iteration = first_iddfs_iteration; iddf_iteration <= helper_context.max_iddfs_iteration(); ++iddf_iteration)
+                    {
+                        state_t duplicated{ snapshot };
+                        helper_context.evaluator()->add_observers(duplicated);
+                        helper_context.evaluator()->query_best_move(duplicated, helper_context, iddf_iteration);
+                    }
+                }
+                catch (...)
+                {
+                    ;
+                }
+            });
+        }
+
         try
         {
             for (iddfs_iteration_t iddf_iteration = 0; iddf_iteration <= context.max_iddfs_iteration(); ++iddf_iteration)
             {
-                state_t duplicated{ state };
+                state_t duplicated{ snapshot };
                 context.evaluator()->add_observers(duplicated);
                 opt_best_move = query_best_move(duplicated, context, iddf_iteration);
                 last_iddfs_iteration = iddf_iteration;
@@ -5872,6 +8491,10 @@ namespace shogipp
             std::cerr << "best_move_iddfs failed" << std::endl;
         }
 
+        context.request_stop();
+        for (std::thread & helper_thread : helper_threads)
+            helper_thread.join();
+
         // őP擾łȂꍇKȍ@IB
         if (!opt_best_move)
         {
@@ -5932,7 +8555,9 @@ namespace shogipp
     {
         std::cout
             << "shogipp.exe" << std::endl
-            << "shogipp.exe --black <evaluator> --white <evaluator> [--max-depth <max-depth>] [--max-selective-depth <max-selective-depth>]" << std::endl
+            << "shogipp.exe --black <evaluator> --white <evaluator> [--max-depth <max-depth>] [--max-selective-depth <max-selective-depth>] [--cache-size <cache-size-MB>] [--threads <thread-number>] [--parallel-mode <lazy-smp|ybwc|deterministic-ybwc>] [--pvs <true|false>]" << std::endl
+            << "shogipp.exe --perft <depth> [--sfen <sfen>] [--perft-thread-number <thread-number>] [--perft-table-size <table-size-MB>]" << std::endl
+            << "shogipp.exe --verify-checks <position-number> [--sfen <sfen>]" << std::endl
             << "shogipp.exe --ga-chromosome <chromosome-directory>" << std::endl
             << "    [--ga-create-chromosome <chromosome-number>]" << std::endl
             << "    [--ga-mutation-rate <ga-mutation-rate>]" << std::endl
@@ -6027,11 +8652,11 @@ namespace shogipp
     {
         evaluation_value_t evaluation_value = 0;
 
-        for (position_t position = position_begin; position < position_end; ++position)
+        bitboard_t sources = state.occupancy();
+        while (!sources.empty())
         {
-            const colored_piece_t piece = state.board[position];
-            if (!board_t::out(position) && !piece.empty())
-                evaluation_value += map[noncolored_piece_t{ piece }.value()] * reverse(piece.to_color());
+            const colored_piece_t piece = state.board[sources.pop()];
+            evaluation_value += map[noncolored_piece_t{ piece }.value()] * reverse(piece.to_color());
         }
 
         for (const color_t color : colors)
@@ -6041,8 +8666,36 @@ namespace shogipp
         return evaluation_value;
     }
 
+    /**
+     * @breif ̔̌ʂ]lɕϊB
+     * @param repetition_state ̔̌
+     * @return Ԃ猩]l
+     * @details Dǖʂї򓙋ǖʂ͋l݂菬Βl̕]lƂB
+     */
+    inline evaluation_value_t repetition_evaluation_value(repetition_state_t repetition_state) noexcept
+    {
+        switch (repetition_state)
+        {
+        case repetition_state_t::win:
+            return std::numeric_limits<evaluation_value_t>::max();
+        case repetition_state_t::lose:
+            return -std::numeric_limits<evaluation_value_t>::max();
+        case repetition_state_t::superior:
+            return std::numeric_limits<evaluation_value_t>::max() / 2;
+        case repetition_state_t::inferior:
+            return -std::numeric_limits<evaluation_value_t>::max() / 2;
+        default:
+            return 0;
+        }
+    }
+
     using evaluated_moves = std::pair<const move_t *, evaluation_value_t>;
 
+    /**
+     * @breif ]lt^ꂽ@̏W
+     */
+    using evaluated_moves_list_t = fixed_vector_t<evaluated_moves, max_moves_size>;
+
     /**
      * @breif @𓾓_ɂёւB
      * @param first evaluated_moves ̐擪w_ANZXCe[^
@@ -6073,6 +8726,303 @@ namespace shogipp
         std::sort(first, last, [](const move_t & a, const move_t & b) -> bool { return to_category(a) > to_category(b); });
     }
 
+    /**
+     * @breif [Ƃ̃L[
+     * @details Zǖʂ beta Jbg𔭐ȂL^B
+     */
+    class killer_table_t
+    {
+    public:
+        constexpr static std::size_t killer_size = 2;
+        using killer_moves_t = std::array<std::optional<move_t>, killer_size>;
+
+        /**
+         * @breif L[L^B
+         * @param depth [
+         * @param move beta Jbg𔭐
+         */
+        inline void push(depth_t depth, const move_t & move)
+        {
+            if (static_cast<std::size_t>(depth) >= m_killer_moves_list.size())
+                m_killer_moves_list.resize(static_cast<std::size_t>(depth) + 1);
+            killer_moves_t & killer_moves = m_killer_moves_list[depth];
+            if (killer_moves.front() && *killer_moves.front() == move)
+                return;
+            std::move_backward(killer_moves.begin(), killer_moves.end() - 1, killer_moves.end());
+            killer_moves.front() = move;
+        }
+
+        /**
+         * @breif L[擾B
+         * @param depth [
+         * @return L[
+         */
+        inline const killer_moves_t & get(depth_t depth) const noexcept
+        {
+            static const killer_moves_t empty_killer_moves{};
+            if (static_cast<std::size_t>(depth) >= m_killer_moves_list.size())
+                return empty_killer_moves;
+            return m_killer_moves_list[depth];
+        }
+
+    private:
+        std::vector<killer_moves_t> m_killer_moves_list;
+    };
+
+    /**
+     * @breif @iKIɐB
+     * @details u\̎AAAL[Ȃ̋𓮂Ał̏ɕԂB
+     *          ̑̋𓮂肨юł́AꂼꉤƂȂɕԂB
+     *          eiK̎͑O̒iK̎SĕԂI܂ŐȂB beta Jbgǖʂł͌̒iK̎̐ȗłB
+     *          肳ĂꍇAO܂Ƃ߂ĐA敪ɂёւĕԂB
+     *          ǖʂ next Ăяo_ō\zƓłȂ΂ȂȂB
+     */
+    class move_picker_t
+    {
+    public:
+        /**
+         * @breif @iKIɐIuWFNg\zB
+         * @param state ǖ
+         * @param hash_move u\̎
+         * @param killer_moves L[
+         */
+        inline move_picker_t(
+            const state_t & state,
+            const std::optional<move_t> & hash_move = std::nullopt,
+            const killer_table_t::killer_moves_t & killer_moves = {}
+        );
+
+        /**
+         * @breif ̍@擾B
+         * @return ̍@w|C^(@肪cĂȂꍇ nullptr)
+         * @details Ԃꂽ|C^͂̃IuWFNgj܂ŗLłB
+         */
+        inline const move_t * next();
+
+    private:
+        enum class stage_t
+        {
+            hash_move,
+            captures_init,
+            captures,
+            promotions_init,
+            promotions,
+            killers,
+            quiets_init,
+            quiets,
+            puts_init,
+            puts,
+            evasions_init,
+            evasions,
+            end
+        };
+
+        /**
+         * @breif ɕԂu\̎肠邢̓L[ł邩肷B
+         * @param move @
+         * @retval true ɕԂ
+         * @retval false ܂ԂĂȂ
+         */
+        inline bool yielded(const move_t & move) const noexcept;
+
+        /**
+         * @breif iǨƂȂԂĂ悢肷B
+         * @param move @
+         * @retval true ԂĂ悢
+         * @retval false ԂĂ͂ȂȂ
+         */
+        inline bool acceptable(const move_t & move) const noexcept;
+
+        /**
+         * @breif m_moves  first ȍ~̎̂A𖞂𐶐ۂđOɏW߂B
+         * @param first ёւ͈͂̐擪̓Y
+         * @param predicate OɏW߂̏
+         * @return 𖞂Ȃŏ̎̓Y
+         * @details std::stable_partition ƈقȂAꎞ̈𓮓IɊmۂȂB
+         */
+        template<typename Predicate>
+        inline std::size_t stable_partition(std::size_t first, Predicate predicate);
+
+        /**
+         * @breif m_moves  first ȍ~̎̂AƂȂOɏW߂B
+         * @param first ёւ͈͂̐擪̓Y
+         * @details J͔肵ȂB
+         */
+        inline void partition_checks(std::size_t first);
+
+        const state_t & m_state;
+        stage_t m_stage;
+        std::optional<move_t> m_hash_move;
+        killer_table_t::killer_moves_t m_killer_moves;
+        std::size_t m_killer_index = 0;
+        std::optional<move_t> m_yielded_moves[1 + killer_table_t::killer_size];
+        std::size_t m_yielded_size = 0;
+        moves_t m_moves;
+        std::size_t m_current = 0;
+        std::size_t m_quiets_begin = 0;
+    };
+
+    inline move_picker_t::move_picker_t(
+        const state_t & state,
+        const std::optional<move_t> & hash_move,
+        const killer_table_t::killer_moves_t & killer_moves
+    )
+        : m_state{ state }
+        , m_stage{ state.check_list().empty() ? stage_t::hash_move : stage_t::evasions_init }
+        , m_hash_move{ hash_move }
+        , m_killer_moves{ killer_moves }
+    {
+    }
+
+    inline bool move_picker_t::yielded(const move_t & move) const noexcept
+    {
+        for (std::size_t i = 0; i < m_yielded_size; ++i)
+            if (*m_yielded_moves[i] == move)
+                return true;
+        return false;
+    }
+
+    inline bool move_picker_t::acceptable(const move_t & move) const noexcept
+    {
+        return !yielded(move);
+    }
+
+    template<typename Predicate>
+    inline std::size_t move_picker_t::stable_partition(std::size_t first, Predicate predicate)
+    {
+        // 𖞂ȂŒ蒷̈ꎞ̈ɑޔĂɏ߂B
+        moves_t rejected;
+        std::size_t last = first;
+        for (std::size_t i = first; i < m_moves.size(); ++i)
+        {
+            if (predicate(m_moves[i]))
+                m_moves[last++] = m_moves[i];
+            else
+                rejected.push_back(m_moves[i]);
+        }
+        std::copy(rejected.begin(), rejected.end(), m_moves.begin() + last);
+        return last;
+    }
+
+    inline void move_picker_t::partition_checks(std::size_t first)
+    {
+        bitboard_t check_squares[noncolored_piece_size];
+        m_state.search_check_squares(check_squares);
+        stable_partition(first, [&](const move_t & move)
+        {
+            if (move.put())
+                return check_squares[move.captured_piece().value()].test(move.destination());
+            const colored_piece_t piece = move.promote() ? move.source_piece().to_promoted() : move.source_piece();
+            return check_squares[noncolored_piece_t{ piece }.value()].test(move.destination());
+        });
+    }
+
+    inline const move_t * move_picker_t::next()
+    {
+        while (true)
+        {
+            switch (m_stage)
+            {
+            case stage_t::hash_move:
+                m_stage = stage_t::captures_init;
+                if (m_hash_move && m_state.is_legal(*m_hash_move) && acceptable(*m_hash_move))
+                {
+                    m_yielded_moves[m_yielded_size] = *m_hash_move;
+                    return &*m_yielded_moves[m_yielded_size++];
+                }
+                break;
+
+            case stage_t::captures_init:
+                m_state.search_moves_moves(std::back_inserter(m_moves), m_state.occupancy(!m_state.color()));
+                m_stage = stage_t::captures;
+                break;
+
+            case stage_t::captures:
+                while (m_current < m_moves.size())
+                    if (const move_t & move = m_moves[m_current++]; acceptable(move))
+                        return &move;
+                m_stage = stage_t::promotions_init;
+                break;
+
+            case stage_t::promotions_init:
+                // Ȃ𐶐AOɏW߂BȂ quiets ŕԂB
+                m_current = m_moves.size();
+                m_state.search_moves_moves(std::back_inserter(m_moves), ~m_state.occupancy());
+                m_quiets_begin = stable_partition(m_current, [](const move_t & move) { return move.promote(); });
+                m_stage = stage_t::promotions;
+                break;
+
+            case stage_t::promotions:
+                while (m_current < m_quiets_begin)
+                    if (const move_t & move = m_moves[m_current++]; acceptable(move))
+                        return &move;
+                m_stage = stage_t::killers;
+                break;
+
+            case stage_t::killers:
+                while (m_killer_index < m_killer_moves.size())
+                {
+                    // 肨ѐ͑O̒iKŊɕԂĂB
+                    const std::optional<move_t> & killer_move = m_killer_moves[m_killer_index++];
+                    if (killer_move
+                        && (killer_move->put() || (killer_move->destination_piece().empty() && !killer_move->promote()))
+                        && m_state.is_legal(*killer_move)
+                        && acceptable(*killer_move))
+                    {
+                        m_yielded_moves[m_yielded_size] = *killer_move;
+                        return &*m_yielded_moves[m_yielded_size++];
+                    }
+                }
+                m_stage = stage_t::quiets_init;
+                break;
+
+            case stage_t::quiets_init:
+                partition_checks(m_current);
+                m_stage = stage_t::quiets;
+                break;
+
+            case stage_t::quiets:
+                while (m_current < m_moves.size())
+                    if (const move_t & move = m_moves[m_current++]; acceptable(move))
+                        return &move;
+                m_stage = stage_t::puts_init;
+                break;
+
+            case stage_t::puts_init:
+                m_state.search_moves_puts(std::back_inserter(m_moves));
+                partition_checks(m_current);
+                m_stage = stage_t::puts;
+                break;
+
+            case stage_t::puts:
+                while (m_current < m_moves.size())
+                    if (const move_t & move = m_moves[m_current++]; acceptable(move))
+                        return &move;
+                m_stage = stage_t::end;
+                break;
+
+            case stage_t::evasions_init:
+                m_state.search_moves_escapes(std::back_inserter(m_moves));
+                sort_moves_by_category(m_moves.begin(), m_moves.end());
+                if (m_hash_move)
+                    if (const auto iter = std::find(m_moves.begin(), m_moves.end(), *m_hash_move); iter != m_moves.end())
+                        std::rotate(m_moves.begin(), iter, iter + 1);
+                m_stage = stage_t::evasions;
+                break;
+
+            case stage_t::evasions:
+                while (m_current < m_moves.size())
+                    if (const move_t & move = m_moves[m_current++]; acceptable(move))
+                        return &move;
+                m_stage = stage_t::end;
+                break;
+
+            case stage_t::end:
+                return nullptr;
+            }
+        }
+    }
+
     /**
      * @breif @̕]lɂёւB
      * @param first first ̐擪w_ANZXCe[^
@@ -6088,6 +9038,7 @@ namespace shogipp
      * @breif USIvgRŃNCAgT[o[ɑM\B
      * @details ̃NX̃o֐̓XbhZ[tɎsB
      *          ̃NX̃o֐QƂꍇA mutex oϐ𗘗pĔr䂷邱ƁB
+     *          TǖʐȂǂ̌v͒TXbhƂɕێAo͂鎞_ŏWvB
      */
     class usi_info_t
     {
@@ -6100,17 +9051,14 @@ namespace shogipp
             requested_to_stop
         };
 
-        depth_t depth{};
         depth_t seldepth{};
         std::chrono::system_clock::time_point begin;
-        search_count_t nodes{};
         std::vector<move_t> pv;
         // multipv
         evaluation_value_t cp{};
         move_count_t mate{};
         std::optional<move_t> currmove;
         std::optional<move_t> best_move;
-        search_count_t cache_hit_count{};
         state_t state = state_t::not_ready;
         std::chrono::milliseconds limit_time{};
         std::map<std::string, std::string> options;
@@ -6118,6 +9066,45 @@ namespace shogipp
 
         mutable std::recursive_mutex mutex;
 
+        /**
+         * @breif ݂̒T[xԂB
+         * @return SĂ̒TXbh̒T[x̍ől
+         */
+        inline depth_t depth() const
+        {
+            std::lock_guard<decltype(mutex)> lock{ mutex };
+            depth_t depth = 0;
+            for (const counter_t & counter : m_counters)
+                depth = std::max(depth, counter.depth.load(std::memory_order_relaxed));
+            return depth;
+        }
+
+        /**
+         * @breif TǖʐԂB
+         * @return SĂ̒TXbh̒Tǖʐ̍v
+         */
+        inline search_count_t nodes() const
+        {
+            std::lock_guard<decltype(mutex)> lock{ mutex };
+            search_count_t nodes = 0;
+            for (const counter_t & counter : m_counters)
+                nodes += counter.nodes.load(std::memory_order_relaxed);
+            return nodes;
+        }
+
+        /**
+         * @breif LbVKpTǖʐԂB
+         * @return SĂ̒TXbh̃LbVKpTǖʐ̍v
+         */
+        inline search_count_t cache_hit_count() const
+        {
+            std::lock_guard<decltype(mutex)> lock{ mutex };
+            search_count_t cache_hit_count = 0;
+            for (const counter_t & counter : m_counters)
+                cache_hit_count += counter.cache_hit_count.load(std::memory_order_relaxed);
+            return cache_hit_count;
+        }
+
         /**
          * @breif begin ƌݎԂ̍~bPʂŕԂB
          * @return begin ƌݎԂ̍
@@ -6136,9 +9123,10 @@ namespace shogipp
         inline search_count_t hashfull() const
         {
             std::lock_guard<decltype(mutex)> lock{ mutex };
+            const search_count_t nodes = this->nodes();
             if (nodes == 0)
                 return 0;
-            return cache_hit_count * 1000 / nodes;
+            return cache_hit_count() * 1000 / nodes;
         }
 
         /**
@@ -6151,7 +9139,7 @@ namespace shogipp
             const std::chrono::milliseconds milli_second_time = time();
             if (milli_second_time.count() == 0)
                 return 0;
-            return nodes * 1000 / milli_second_time.count();
+            return nodes() * 1000 / milli_second_time.count();
         }
 
         /**
@@ -6180,10 +9168,10 @@ namespace shogipp
         {
             std::lock_guard<decltype(mutex)> lock{ mutex };
             std::cout << "info"
-                << " depth " << depth
+                << " depth " << depth()
                 << " seldepth " << seldepth
                 << " time " << time().count()
-                << " nodes " << nodes
+                << " nodes " << nodes()
                 << " hashfull " << hashfull()
                 << " nps " << nps()
                 << std::endl;
@@ -6243,27 +9231,39 @@ namespace shogipp
         }
 
         /**
-         * @breif depth  nodes XVB
+         * @breif T̒~vB
+         * @details TXbh resolve_request_to_stop Œ~̗voB
+         */
+        inline void request_to_stop()
+        {
+            std::lock_guard<decltype(mutex)> lock{ mutex };
+            state = state_t::requested_to_stop;
+            m_requested_to_stop.store(true);
+        }
+
+        /**
+         * @breif ĂяoXbh̒T[xƒTǖʐXVB
          * @param depth ݂̒T[x
          * @details ̊֐ USI T[o[ stop R}hʒmĂꍇA timeout_exception 𑗏oB
          *          ̊֐͍ċAIɌĂяoT֐̐擪ŌĂяoKvB
+         *          SĂ̐ߓ_ŌĂяo邽߁Ar䂵ȂB
          */
         inline void resolve_request_to_stop(depth_t depth)
         {
-            std::lock_guard<decltype(mutex)> lock{ mutex };
-            if (state == usi_info_t::state_t::requested_to_stop)
+            if (m_requested_to_stop.load(std::memory_order_relaxed))
                 throw timeout_exception{ "requested to stop" };
-            this->depth = depth;
-            this->nodes += 1;
+            counter_t & counter = this->counter();
+            counter.depth.store(depth, std::memory_order_relaxed);
+            counter.nodes.store(counter.nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         }
 
         /**
-         * @breif cache_hit_count 1B
+         * @breif ĂяoXbh cache_hit_count 1B
          */
         inline void increase_cache_hit_count()
         {
-            std::lock_guard<decltype(mutex)> lock{ mutex };
-            ++cache_hit_count;
+            counter_t & counter = this->counter();
+            counter.cache_hit_count.store(counter.cache_hit_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         }
 
         /**
@@ -6299,6 +9299,51 @@ namespace shogipp
             begin = std::chrono::system_clock::now();
             state = usi_info_t::state_t::searching;
         }
+
+    private:
+        /**
+         * @breif TXbhƂ̌v
+         * @details eTXbh͎ǧv݂̂ނ߁Asȓǂݍ݂Ə݂ōXVB
+         *          ̃XbȟvƓLbVCɔzuȂB
+         */
+        class alignas(64) counter_t
+        {
+        public:
+            std::atomic<depth_t> depth{};
+            std::atomic<search_count_t> nodes{};
+            std::atomic<search_count_t> cache_hit_count{};
+        };
+
+        /**
+         * @breif usi_info_t ʂԍ𐶐B
+         */
+        inline static std::uint64_t make_id() noexcept
+        {
+            static std::atomic<std::uint64_t> id{ 0 };
+            return ++id;
+        }
+
+        /**
+         * @breif ĂяoXbȟv擾B
+         * @details XbhƂɍŏ̌ĂяoŌvo^B
+         *          usi_info_t ̓AhXėpꂤ邽߁AAhXł͂Ȃʔԍœo^ς݂肷B
+         */
+        inline counter_t & counter()
+        {
+            thread_local std::uint64_t registered_id = 0;
+            thread_local counter_t * registered_counter = nullptr;
+            if (registered_id != m_id)
+            {
+                std::lock_guard<decltype(mutex)> lock{ mutex };
+                registered_counter = &m_counters.emplace_back();
+                registered_id = m_id;
+            }
+            return *registered_counter;
+        }
+
+        const std::uint64_t m_id = make_id();
+        std::deque<counter_t> m_counters;   // TXbhƂ̌v(mutex ŕی삷)
+        std::atomic<bool> m_requested_to_stop{ false };
     };
 
     /**
@@ -6317,6 +9362,293 @@ namespace shogipp
         virtual evaluation_value_t evaluate(state_t & state) = 0;
     };
 
+    /**
+     * @breif d𓐂ݍXbhv[
+     * @details eXbh͎g̗[L[Bd͒ǉXbh̃L[̖ɐς܂A
+     *          eXbh͎g̃L[̖Ag̃L[̏ꍇ͑̃Xbh̃L[̐擪d擾B
+     *          v[\zXbh͔ԍ 0 ̃L[gpB
+     *          parallel_for ő҂Xbh́ǍĂяo̎dƂ炩hd݂̂AłdȂΏϐő҂B
+     */
+    class work_stealing_pool_t
+    {
+    public:
+        /**
+         * @breif Xbhv[\zB
+         * @param thread_number v[\zXbh܂ރXbh̐
+         */
+        inline explicit work_stealing_pool_t(unsigned int thread_number);
+
+        inline work_stealing_pool_t(const work_stealing_pool_t &) = delete;
+        inline work_stealing_pool_t & operator =(const work_stealing_pool_t &) = delete;
+
+        /**
+         * @breif SẴXbhIB
+         * @details L[Ɏcd͎sȂB
+         */
+        inline ~work_stealing_pool_t();
+
+        /**
+         * @breif 0  size - 1 ܂ł̓YŊ֐ɌĂяoASĂ̌ĂяoI܂ő҂B
+         * @param size Ăяỏ
+         * @param function YɎ֐
+         * @details ҂ԁAĂяoXbh͂̌Ăяo̎dƁA̎dĂяoꂽ parallel_for ̎d݂̂B
+         *          ֌WȎdāǍĂяoI҂邱Ƃ͂ȂB
+         *          ꂩ̌ĂяoO𑗏oꍇA܂JnĂȂĂяoȗASĂ̌ĂяoIɍŏ̗OđoB
+         */
+        template<typename Function>
+        inline void parallel_for(std::size_t size, Function && function);
+
+    private:
+        /**
+         * @breif parallel_for 1̌ĂяoŒǉꂽd̏W܂
+         */
+        class group_t
+        {
+        public:
+            const group_t * parent{};                   // parallel_for Ăяod̏W܂(d̊OŌĂяoꂽꍇ nullptr)
+            std::atomic<std::size_t> remaining_size{};  // IĂȂd̐
+        };
+
+        class task_t
+        {
+        public:
+            std::function<void()> function;
+            const group_t * group{};
+        };
+
+        class queue_t
+        {
+        public:
+            std::mutex mutex;
+            std::deque<task_t> tasks;
+        };
+
+        /**
+         * @breif ĂяoXbh̃L[̔ԍ擾B
+         */
+        inline static std::size_t & thread_index() noexcept;
+
+        /**
+         * @breif ĂяoXbhĂd̏W܂擾B
+         */
+        inline static const group_t *& current_group() noexcept;
+
+        /**
+         * @breif d̏W܂肪̎d̏W܂̎q肷B
+         * @param group d̏W܂
+         * @param ancestor c̎d̏W܂
+         * @retval true group  ancestor ܂͂̎qł
+         * @retval false group  ancestor ̎qłȂ
+         */
+        inline static bool is_descendant(const group_t * group, const group_t * ancestor) noexcept;
+
+        /**
+         * @breif ĂяoXbh̃L[ɎdǉB
+         * @param task d
+         */
+        inline void push(task_t task);
+
+        /**
+         * @breif d1擾ĎsB
+         * @param group sd̏W܂̑c(Cӂ̎dsꍇ nullptr)
+         * @retval true ds
+         * @retval false słdȂ
+         */
+        inline bool run_one(const group_t * group);
+
+        /**
+         * @breif d擾B
+         * @param group 擾d̏W܂̑c(Cӂ̎d擾ꍇ nullptr)
+         * @return d(słdȂꍇ std::nullopt)
+         */
+        inline std::optional<task_t> pop(const group_t * group);
+
+        /**
+         * @breif ⏕Xbh̏
+         * @param index L[̔ԍ
+         */
+        inline void worker(std::size_t index);
+
+        std::vector<std::unique_ptr<queue_t>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<std::size_t> m_queued_size{ 0 };
+        std::mutex m_mutex;
+        std::condition_variable m_condition;            // ⏕XbhɎd̒ǉʒmB
+        std::condition_variable m_waiting_condition;    // parallel_for ő҂XbhɎd̒ǉƏIʒmB
+        std::atomic<std::size_t> m_event_count{ 0 };    // d̒ǉƏỈ(m_mutex lčXV)
+        bool m_stop = false;
+    };
+
+    inline work_stealing_pool_t::work_stealing_pool_t(unsigned int thread_number)
+    {
+        thread_number = std::max(thread_number, 1u);
+        for (unsigned int i = 0; i < thread_number; ++i)
+            m_queues.push_back(std::make_unique<queue_t>());
+        for (unsigned int i = 1; i < thread_number; ++i)
+            m_threads.emplace_back(&work_stealing_pool_t::worker, this, static_cast<std::size_t>(i));
+    }
+
+    inline work_stealing_pool_t::~work_stealing_pool_t()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (std::thread & thread : m_threads)
+            thread.join();
+    }
+
+    template<typename Function>
+    inline void work_stealing_pool_t::parallel_for(std::size_t size, Function && function)
+    {
+        group_t group;
+        group.parent = current_group();
+        group.remaining_size = size;
+        std::atomic<bool> aborted{ false };
+        std::mutex mutex;
+        std::exception_ptr exception;
+
+        // ĂяoXbh̓L[̖d擾邽߁AO̓Y珈悤tɒǉB
+        for (std::size_t i = size; i-- > 0;)
+        {
+            push(task_t{ [&, i]()
+            {
+                try
+                {
+                    if (!aborted.load())
+                        function(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock{ mutex };
+                    if (!exception)
+                        exception = std::current_exception();
+                    aborted = true;
+                }
+                group.remaining_size.fetch_sub(1);
+            }, &group });
+        }
+
+        // SĂ̌ĂяoI܂ŁǍĂяo̎dƂ炩hdB
+        // łdȂ΁Adǉ邩I܂ő҂B
+        while (true)
+        {
+            const std::size_t event_count = m_event_count.load();
+            if (group.remaining_size.load() == 0)
+                break;
+            if (run_one(&group))
+                continue;
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_waiting_condition.wait(lock, [&]() { return m_event_count.load() != event_count; });
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    inline std::size_t & work_stealing_pool_t::thread_index() noexcept
+    {
+        thread_local std::size_t index = 0;
+        return index;
+    }
+
+    inline const work_stealing_pool_t::group_t *& work_stealing_pool_t::current_group() noexcept
+    {
+        thread_local const group_t * group = nullptr;
+        return group;
+    }
+
+    inline bool work_stealing_pool_t::is_descendant(const group_t * group, const group_t * ancestor) noexcept
+    {
+        for (; group; group = group->parent)
+            if (group == ancestor)
+                return true;
+        return false;
+    }
+
+    inline void work_stealing_pool_t::push(task_t task)
+    {
+        queue_t & queue = *m_queues[thread_index()];
+        {
+            std::lock_guard<std::mutex> lock{ queue.mutex };
+            queue.tasks.push_back(std::move(task));
+        }
+        m_queued_size.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            ++m_event_count;
+        }
+        m_condition.notify_one();
+        m_waiting_condition.notify_all();
+    }
+
+    inline bool work_stealing_pool_t::run_one(const group_t * group)
+    {
+        std::optional<task_t> task = pop(group);
+        if (!task)
+            return false;
+
+        // dĂяoꂽ parallel_for ̎d̏W܂́A̎d̏W܂̎qɂȂB
+        const group_t * const previous_group = current_group();
+        current_group() = task->group;
+        task->function();
+        current_group() = previous_group;
+
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            ++m_event_count;
+        }
+        m_waiting_condition.notify_all();
+        return true;
+    }
+
+    inline std::optional<work_stealing_pool_t::task_t> work_stealing_pool_t::pop(const group_t * group)
+    {
+        const std::size_t index = thread_index();
+        for (std::size_t i = 0; i < m_queues.size(); ++i)
+        {
+            queue_t & queue = *m_queues[(index + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock{ queue.mutex };
+            if (queue.tasks.empty())
+                continue;
+            std::optional<task_t> task;
+            if (i == 0)
+            {
+                const auto iter = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), [group](const task_t & task) { return !group || is_descendant(task.group, group); });
+                if (iter == queue.tasks.rend())
+                    continue;
+                task = std::move(*iter);
+                queue.tasks.erase(std::next(iter).base());
+            }
+            else
+            {
+                const auto iter = std::find_if(queue.tasks.begin(), queue.tasks.end(), [group](const task_t & task) { return !group || is_descendant(task.group, group); });
+                if (iter == queue.tasks.end())
+                    continue;
+                task = std::move(*iter);
+                queue.tasks.erase(iter);
+            }
+            m_queued_size.fetch_sub(1);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    inline void work_stealing_pool_t::worker(std::size_t index)
+    {
+        thread_index() = index;
+        while (true)
+        {
+            if (run_one(nullptr))
+                continue;
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_condition.wait(lock, [this]() { return m_stop || m_queued_size.load() > 0; });
+            if (m_stop)
+                break;
+        }
+    }
+
     /**
      * @breif negamax ō@I]֐IuWFNg̒ۃNX
      */
@@ -6326,15 +9658,17 @@ namespace shogipp
     {
     public:
         move_t query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration) override;
+        bool supports_lazy_smp() const override { return false; }
         std::shared_ptr<usi_info_t> usi_info;
 
     private:
         class arguments_t
         {
         public:
-            cache_t & cache;
+            transposition_table_t & transposition_table;
             iddfs_context_t & context;
             const depth_t max_depth{};
+            work_stealing_pool_t * const pool{};    // ̋ǖʂ̍@𕪒SXbhv[(T̏ꍇ nullptr)
         };
 
         evaluation_value_t negamax(
@@ -6343,6 +9677,19 @@ namespace shogipp
             std::optional<move_t> & candidate_move,
             arguments_t & arguments
         );
+
+        /**
+         * @breif ̋ǖʂ̍@Xbhv[ŕSĒTB
+         * @param state ̋ǖ
+         * @param moves ̋ǖʂ̍@
+         * @param arguments 
+         * @return @̕]l(moves Ɠ)
+         */
+        std::vector<evaluation_value_t> search_root_moves(
+            state_t & state,
+            const moves_t & moves,
+            arguments_t & arguments
+        );
     };
 
     evaluation_value_t negamax_evaluator_t::negamax(
@@ -6355,14 +9702,22 @@ namespace shogipp
         if (usi_info)
             usi_info->resolve_request_to_stop(depth);
 
+        // ͍@𐶐ɕ]B
+        if (depth > 0)
+            if (const repetition_state_t repetition_state = state.repetition_state(); repetition_state != repetition_state_t::none)
+            {
+                ++details::performance.repetition_count();
+                return repetition_evaluation_value(repetition_state);
+            }
+
         if (depth >= arguments.max_depth)
         {
             if (arguments.context.timeout())
                 throw timeout_exception{ "context.timeout() == true" };
 
             ++details::performance.search_count();
-            const std::optional<cache_value_t> cached_value = arguments.cache.get(state.hash());
-            if (cached_value && cached_value->max_iddfs_iteration == arguments.context.max_iddfs_iteration())
+            const std::optional<cache_value_t> cached_value = arguments.transposition_table.get(state.hash());
+            if (cached_value && cached_value->bound == bound_t::exact)
             {
                 ++details::performance.cache_hit_count();
                 if (usi_info)
@@ -6370,26 +9725,35 @@ namespace shogipp
                 return cached_value->evaluation_value;
             }
             const evaluation_value_t evaluation_value = evaluate(state) * reverse(state.color());
-            arguments.cache.push(state.hash(), cache_value_t{ evaluation_value, arguments.context.max_iddfs_iteration() });
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::exact, std::nullopt });
             return evaluation_value;
         }
 
-        moves_t moves = state.search_moves();
+        moves_t moves = depth == 0 ? state.search_moves() : state.nonstrict_search_moves();
 
         if (moves.empty())
             return -std::numeric_limits<evaluation_value_t>::max();
 
-        std::vector<evaluated_moves> evaluated_moves;
+        evaluated_moves_list_t evaluated_moves;
         auto inserter = std::back_inserter(evaluated_moves);
         evaluation_value_t max_evaluation_value = -std::numeric_limits<evaluation_value_t>::max();
 
-        for (const move_t & move : moves)
+        // ̋ǖʂł͍@XbhԂŕSĒTAʂ@̏ɏWvB
+        std::vector<evaluation_value_t> root_evaluation_values;
+        if (depth == 0 && arguments.pool)
+            root_evaluation_values = search_root_moves(state, moves, arguments);
+
+        for (std::size_t i = 0; i < moves.size(); ++i)
         {
+            const move_t & move = moves[i];
             if (usi_info && depth == 0)
                 usi_info->notify_currmove(move);
 
             std::optional<move_t> nested_candidate_move;
             evaluation_value_t evaluation_value;
+            if (!root_evaluation_values.empty())
+                evaluation_value = root_evaluation_values[i];
+            else
             {
                 VALIDATE_STATE_ROLLBACK(state);
                 state.do_move(move);
@@ -6410,6 +9774,31 @@ namespace shogipp
         return evaluated_moves.front().second;
     }
 
+    std::vector<evaluation_value_t> negamax_evaluator_t::search_root_moves(
+        state_t & state,
+        const moves_t & moves,
+        arguments_t & arguments
+    )
+    {
+        std::vector<evaluation_value_t> evaluation_values(moves.size());
+        const state_snapshot_t snapshot = state.snapshot();
+
+        arguments.pool->parallel_for(moves.size(), [&](std::size_t i)
+        {
+            // stop R}hMł悤AeXbh̒Tł usi_info LB
+            const auto evaluator = std::static_pointer_cast<negamax_evaluator_t>(clone());
+            evaluator->usi_info = usi_info;
+            state_t child{ snapshot };
+            evaluator->add_observers(child);
+            child.do_move(moves[i]);
+            arguments_t child_arguments{ arguments.transposition_table, arguments.context, arguments.max_depth };
+            std::optional<move_t> nested_candidate_move;
+            evaluation_values[i] = -evaluator->negamax(child, 1, nested_candidate_move, child_arguments);
+        });
+
+        return evaluation_values;
+    }
+
     move_t negamax_evaluator_t::query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration)
     {
         if (usi_info)
@@ -6418,7 +9807,12 @@ namespace shogipp
         std::optional<move_t> candidate_move;
         evaluation_value_t evaluation_value;
         const depth_t max_depth = iddfs_iteration * 2 + 1;
-        arguments_t arguments{ context.cache(), context, max_depth };
+
+        // ̃XbhŒTꍇAƂɃXbhv[\zB
+        std::unique_ptr<work_stealing_pool_t> pool;
+        if (context.thread_number() > 1 && std::dynamic_pointer_cast<negamax_evaluator_t>(clone()))
+            pool = std::make_unique<work_stealing_pool_t>(context.thread_number());
+        arguments_t arguments{ context.transposition_table(), context, max_depth, pool.get() };
 
         try
         {
@@ -6447,17 +9841,43 @@ namespace shogipp
     {
     public:
         move_t query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration) override;
+        bool supports_ybwc() const override { return true; }
         std::shared_ptr<usi_info_t> usi_info;
 
     private:
+        /**
+         * @breif YBWC ŌZߓ_𕪒Sߓ_̎c̒T[̍ŏl
+         * @details 󂢐ߓ_ŕSƁAǖʂ̕ƃXbhԂ̓̔pT̔pB
+         */
+        constexpr static depth_t min_split_draft = 4;
+
+        /**
+         * @breif I YBWC ŌZߓ_ƂɎgpu\̑傫[byte]
+         */
+        constexpr static std::size_t sibling_transposition_table_size = 256 * 1024;
+
         class arguments_t
         {
         public:
-            cache_t & cache;
+            transposition_table_t & transposition_table;
             iddfs_context_t & context;
+            killer_table_t & killer_table;
             const depth_t max_depth{};
+            work_stealing_pool_t * const pool{};    // YBWC ŌZߓ_𕪒SXbhv[(T̏ꍇ nullptr)
+            const arguments_t * const parent{};     // I YBWC ŌZߓ_𕪒Sߓ_̈(ȊȌꍇ nullptr)
+            search_count_t repetition_count{};      // ̒TŐɂ]ǖʐ(u\ɕ]lL^Ă悢̔Ɏgp)
         };
 
+        /**
+         * @breif u\ǖʂɑΉl擾B
+         * @param arguments 
+         * @param hash ǖʂ̃nbVl
+         * @return ǖʂɑΉl(u\ɑ݂Ȃꍇ std::nullopt)
+         * @details I YBWC ł́AZߓ_̒u\ɑ݂ȂΕSߓ_̒u\珇Ɏ擾B
+         *          ̒u\͌Zߓ_TԍXVȂB
+         */
+        static std::optional<cache_value_t> get_cache(const arguments_t & arguments, const hash_t & hash);
+
         evaluation_value_t alphabeta(
             state_t & state,
             depth_t depth,
@@ -6466,6 +9886,31 @@ namespace shogipp
             std::optional<move_t> & candidate_move,
             arguments_t & arguments
         );
+
+        /**
+         * @breif Zߓ_Xbhv[ŕSĒTB
+         * @param state Zߓ_̐e̋ǖ
+         * @param depth Zߓ_̐e̐[
+         * @param alpha ZT alpha
+         * @param beta beta
+         * @param siblings Zߓ_Ɏ
+         * @param arguments 
+         * @return Zߓ_̕]l(siblings Ɠ)
+         * @details eZߓ_͒TJn_ő̌Zߓ_ɂXVꂽ alpha pĒTB
+         *          alpha ȉ̕]l͏lł邽߁A]l̍ől̓Xbh̎sɈˑȂB
+         *          beta JbgZߓ_̌Zߓ_́A܂TJnĂȂΒTȂB
+         *          ̌Zߓ_̕]l͖KłB
+         *          I YBWC ł́AeZߓ_͈ alpha ɂ null window Ōʂ̒u\ɏ݂ȂTB
+         *          SĂ̌Zߓ_̒TIAY̏ɒu\𓝍A alpha Zߓ_ĒTB
+         */
+        std::vector<evaluation_value_t> search_siblings(
+            state_t & state,
+            depth_t depth,
+            evaluation_value_t alpha,
+            evaluation_value_t beta,
+            const std::vector<const move_t *> & siblings,
+            arguments_t & arguments
+        );
     };
 
     evaluation_value_t alphabeta_evaluator_t::alphabeta(
@@ -6480,14 +9925,23 @@ namespace shogipp
         if (usi_info)
             usi_info->resolve_request_to_stop(depth);
 
+        // ͍@𐶐ɕ]B
+        if (depth > 0)
+            if (const repetition_state_t repetition_state = state.repetition_state(); repetition_state != repetition_state_t::none)
+            {
+                ++details::performance.repetition_count();
+                ++arguments.repetition_count;
+                return repetition_evaluation_value(repetition_state);
+            }
+
         if (depth >= arguments.max_depth)
         {
             if (arguments.context.timeout())
                 throw timeout_exception{ "context.timeout() == true" };
 
             ++details::performance.search_count();
-            const std::optional<cache_value_t> cached_value = arguments.cache.get(state.hash());
-            if (cached_value && cached_value->max_iddfs_iteration == arguments.context.max_iddfs_iteration())
+            const std::optional<cache_value_t> cached_value = get_cache(arguments, state.hash());
+            if (cached_value && cached_value->cutoff(0, alpha, beta))
             {
                 ++details::performance.cache_hit_count();
                 if (usi_info)
@@ -6495,22 +9949,39 @@ namespace shogipp
                 return cached_value->evaluation_value;
             }
             const evaluation_value_t evaluation_value = evaluate(state) * reverse(state.color());
-            arguments.cache.push(state.hash(), cache_value_t{ evaluation_value, arguments.context.max_iddfs_iteration() });
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::exact, std::nullopt });
             return evaluation_value;
         }
 
-        moves_t moves = state.search_moves();
-        sort_moves_by_category(moves.begin(), moves.end());
-
-        if (moves.empty())
-            return -std::numeric_limits<evaluation_value_t>::max();
+        // u\̕]l\Ȑ[̒Tɂ̂łΒTł؂AłȂΒu\̎ŏɒTB
+        const depth_t draft = arguments.max_depth - depth; // c̒T[
+        const evaluation_value_t original_alpha = alpha;
+        const search_count_t repetition_count = arguments.repetition_count;
+        std::optional<move_t> hash_move;
+        if (const std::optional<cache_value_t> cached_value = get_cache(arguments, state.hash()))
+        {
+            if (depth > 0 && cached_value->cutoff(draft, alpha, beta))
+            {
+                ++details::performance.cache_hit_count();
+                if (usi_info)
+                    usi_info->increase_cache_hit_count();
+                return cached_value->evaluation_value;
+            }
+            hash_move = cached_value->best_move;
+        }
 
-        std::vector<evaluated_moves> evaluated_moves;
+        move_picker_t move_picker{ state, hash_move, arguments.killer_table.get(depth) };
+        evaluated_moves_list_t evaluated_moves;
         auto inserter = std::back_inserter(evaluated_moves);
         evaluation_value_t max_evaluation_value = -std::numeric_limits<evaluation_value_t>::max();
 
-        for (const move_t & move : moves)
+        while (const move_t * const next_move = move_picker.next())
         {
+            const move_t & move = *next_move;
+
+            // ϐ̏ꍇAߋƓ̋ǖʂɎ̋ǖʂőIȂB
+            if (depth == 0 && state.anti_repetition_of_moves && state.is_repetition_move(move))
+                continue;
             if (usi_info && depth == 0)
                 usi_info->notify_currmove(move);
 
@@ -6519,7 +9990,15 @@ namespace shogipp
             {
                 VALIDATE_STATE_ROLLBACK(state);
                 state.do_move(move);
-                evaluation_value = -alphabeta(state, depth + 1, -beta, -alpha, nested_candidate_move, arguments);
+                // PVS: ZȊO null window ŒTAalpha  beta ꍇ̂ (alpha, beta) ̑ōĒTB
+                if (arguments.context.principal_variation_search() && !evaluated_moves.empty())
+                {
+                    evaluation_value = -alphabeta(state, depth + 1, -alpha - 1, -alpha, nested_candidate_move, arguments);
+                    if (evaluation_value > alpha && evaluation_value < beta)
+                        evaluation_value = -alphabeta(state, depth + 1, -beta, -alpha, nested_candidate_move, arguments);
+                }
+                else
+                    evaluation_value = -alphabeta(state, depth + 1, -beta, -alpha, nested_candidate_move, arguments);
                 state.undo_move();
             }
             *inserter++ = { &move, evaluation_value };
@@ -6531,13 +10010,160 @@ namespace shogipp
 
             alpha = std::max(alpha, evaluation_value);
             if (alpha >= beta)
+            {
+                if (move.put() || move.destination_piece().empty())
+                    arguments.killer_table.push(depth, move);
+                break;
+            }
+
+            // YBWC: ZTAc̒T[\łΎčZߓ_XbhԂŕSĒTB
+            if (arguments.pool && draft >= min_split_draft)
+            {
+                std::vector<const move_t *> siblings;
+                while (const move_t * const sibling = move_picker.next())
+                    if (!(depth == 0 && state.anti_repetition_of_moves && state.is_repetition_move(*sibling)))
+                        siblings.push_back(sibling);
+
+                const std::vector<evaluation_value_t> evaluation_values = search_siblings(state, depth, alpha, beta, siblings, arguments);
+                for (std::size_t i = 0; i < siblings.size(); ++i)
+                {
+                    const move_t & sibling = *siblings[i];
+                    *inserter++ = { &sibling, evaluation_values[i] };
+
+                    if (usi_info && depth == 0)
+                    {
+                        usi_info->notify_currmove(sibling);
+                        if (evaluation_values[i] > max_evaluation_value)
+                            usi_info->notify_best_move(sibling, evaluation_values[i]);
+                    }
+
+                    max_evaluation_value = evaluation_values[i];
+
+                    alpha = std::max(alpha, evaluation_values[i]);
+                    if (alpha >= beta)
+                    {
+                        if (sibling.put() || sibling.destination_piece().empty())
+                            arguments.killer_table.push(depth, sibling);
+                        break;
+                    }
+                }
                 break;
+            }
         }
 
-        SHOGIPP_ASSERT(!moves.empty());
+        if (evaluated_moves.empty())
+            return -std::numeric_limits<evaluation_value_t>::max();
+
         sort_moves_by_evaluation_value(evaluated_moves.begin(), evaluated_moves.end());
-        candidate_move = *evaluated_moves.front().first;
-        return evaluated_moves.front().second;
+        const move_t & best_move = *evaluated_moves.front().first;
+        const evaluation_value_t evaluation_value = evaluated_moves.front().second;
+        // ̕]l͋ǖʂɎoHɈˑ邽߁AɊÂ]l͋L^Au\݂̎̂L^B
+        if (arguments.repetition_count == repetition_count)
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, draft, cache_value_t::make_bound(evaluation_value, original_alpha, beta), best_move });
+        else
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::none, best_move });
+        candidate_move = best_move;
+        return evaluation_value;
+    }
+
+    std::vector<evaluation_value_t> alphabeta_evaluator_t::search_siblings(
+        state_t & state,
+        depth_t depth,
+        evaluation_value_t alpha,
+        evaluation_value_t beta,
+        const std::vector<const move_t *> & siblings,
+        arguments_t & arguments
+    )
+    {
+        const bool deterministic = arguments.context.parallel_mode() == parallel_mode_t::deterministic_ybwc;
+        std::vector<evaluation_value_t> evaluation_values(siblings.size(), -std::numeric_limits<evaluation_value_t>::max());
+        std::atomic<evaluation_value_t> max_evaluation_value{ alpha };  // Zߓ_̕]l̍ől
+        std::atomic<std::size_t> cutoff_index{ siblings.size() };       // beta JbgZߓ_̍ŏ̓Y
+        std::vector<search_count_t> repetition_counts(siblings.size()); // Zߓ_̒TŐɂ]ǖʐ
+        std::vector<std::unique_ptr<transposition_table_t>> transposition_tables(siblings.size());  // I YBWC ŌZߓ_ƂɎgpu\(ȊȌꍇ nullptr)
+        const state_snapshot_t snapshot = state.snapshot();
+
+        arguments.pool->parallel_for(siblings.size(), [&](std::size_t i)
+        {
+            if (i >= cutoff_index.load())
+                return;
+
+            // ̌Zߓ_̕]l beta ȏ̏ꍇA̐ߓ_ beta Jbg邽ߒTȂB
+            // shared_alpha ]l̍ől̏ꍇAnull window  -shared_alpha - 1 ͎qߓ_ŕ𔽓]ƌӂꂷB
+            const evaluation_value_t shared_alpha = deterministic ? alpha : max_evaluation_value.load();
+            if (shared_alpha >= beta)
+                return;
+
+            // stop R}hMł悤AZߓ_̒Tł usi_info LB
+            // L[͕S_̕eZߓ_̒TŎgpB
+            const auto evaluator = std::static_pointer_cast<alphabeta_evaluator_t>(clone());
+            evaluator->usi_info = usi_info;
+            state_t child{ snapshot };
+            evaluator->add_observers(child);
+            child.do_move(*siblings[i]);
+            killer_table_t killer_table{ arguments.killer_table };
+            if (deterministic)
+                transposition_tables[i] = std::make_unique<transposition_table_t>(sibling_transposition_table_size);
+            transposition_table_t & transposition_table = deterministic ? *transposition_tables[i] : arguments.transposition_table;
+            arguments_t child_arguments{ transposition_table, arguments.context, killer_table, arguments.max_depth, arguments.pool, deterministic ? &arguments : nullptr };
+            std::optional<move_t> nested_candidate_move;
+            evaluation_value_t evaluation_value;
+            if (deterministic || arguments.context.principal_variation_search())
+            {
+                evaluation_value = -evaluator->alphabeta(child, depth + 1, -shared_alpha - 1, -shared_alpha, nested_candidate_move, child_arguments);
+                if (!deterministic && evaluation_value > shared_alpha && evaluation_value < beta)
+                    evaluation_value = -evaluator->alphabeta(child, depth + 1, -beta, -shared_alpha, nested_candidate_move, child_arguments);
+            }
+            else
+                evaluation_value = -evaluator->alphabeta(child, depth + 1, -beta, -shared_alpha, nested_candidate_move, child_arguments);
+            evaluation_values[i] = evaluation_value;
+            repetition_counts[i] = child_arguments.repetition_count;
+
+            evaluation_value_t expected = max_evaluation_value.load();
+            while (evaluation_value > expected && !max_evaluation_value.compare_exchange_weak(expected, evaluation_value))
+                ;
+            if (evaluation_value >= beta)
+            {
+                std::size_t expected_index = cutoff_index.load();
+                while (i < expected_index && !cutoff_index.compare_exchange_weak(expected_index, i))
+                    ;
+            }
+        });
+
+        if (!deterministic)
+        {
+            // Zߓ_𑼂̃XbhTꍇAc̐ߓ_Ɉˑ]lL^Ȃ悤ɂB
+            for (const search_count_t repetition_count : repetition_counts)
+                arguments.repetition_count += repetition_count;
+            return evaluation_values;
+        }
+
+        // I YBWC: Zߓ_Y̏ɏAu\𓝍āAnull window  alpha Zߓ_ (alpha, beta) ̑ōĒTB
+        // ŏ beta JbgZߓ_܂ł͕KTĂ邽߁ATJnXbh̎sɈˑZߓ_͏ȂB
+        evaluation_value_t current_alpha = alpha;
+        for (std::size_t i = 0; i < siblings.size() && current_alpha < beta; ++i)
+        {
+            arguments.repetition_count += repetition_counts[i];
+            arguments.transposition_table.merge(*transposition_tables[i]);
+            if (evaluation_values[i] > alpha && evaluation_values[i] < beta)
+            {
+                VALIDATE_STATE_ROLLBACK(state);
+                state.do_move(*siblings[i]);
+                std::optional<move_t> nested_candidate_move;
+                evaluation_values[i] = -alphabeta(state, depth + 1, -beta, -current_alpha, nested_candidate_move, arguments);
+                state.undo_move();
+            }
+            current_alpha = std::max(current_alpha, evaluation_values[i]);
+        }
+        return evaluation_values;
+    }
+
+    std::optional<cache_value_t> alphabeta_evaluator_t::get_cache(const arguments_t & arguments, const hash_t & hash)
+    {
+        for (const arguments_t * current = &arguments; current; current = current->parent)
+            if (const std::optional<cache_value_t> cached_value = current->transposition_table.get(hash))
+                return cached_value;
+        return std::nullopt;
     }
 
     move_t alphabeta_evaluator_t::query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration)
@@ -6548,7 +10174,13 @@ namespace shogipp
         std::optional<move_t> candidate_move;
         evaluation_value_t evaluation_value;
         const depth_t max_depth = iddfs_iteration * 2 + 1;
-        arguments_t arguments{ context.cache(), context, max_depth };
+        killer_table_t killer_table;
+
+        // YBWC ̏ꍇAƂɃXbhv[\zB
+        std::unique_ptr<work_stealing_pool_t> pool;
+        if (context.parallel_mode() != parallel_mode_t::lazy_smp && context.thread_number() > 1 && std::dynamic_pointer_cast<alphabeta_evaluator_t>(clone()))
+            pool = std::make_unique<work_stealing_pool_t>(context.thread_number());
+        arguments_t arguments{ context.transposition_table(), context, killer_table, max_depth, pool.get() };
 
         try
         {
@@ -6584,10 +10216,12 @@ namespace shogipp
         class arguments_t
         {
         public:
-            cache_t & cache;
+            transposition_table_t & transposition_table;
             iddfs_context_t & context;
+            killer_table_t & killer_table;
             const depth_t max_depth{};
             const depth_t max_selective_depth{};
+            search_count_t repetition_count{};  // ̒TŐɂ]ǖʐ(u\ɕ]lL^Ă悢̔Ɏgp)
         };
 
         evaluation_value_t extendable_alphabeta(
@@ -6614,6 +10248,15 @@ namespace shogipp
         if (usi_info)
             usi_info->resolve_request_to_stop(depth);
 
+        // ͍@𐶐ɕ]B
+        if (depth > 0)
+            if (const repetition_state_t repetition_state = state.repetition_state(); repetition_state != repetition_state_t::none)
+            {
+                ++details::performance.repetition_count();
+                ++arguments.repetition_count;
+                return repetition_evaluation_value(repetition_state);
+            }
+
         if (depth >= arguments.max_depth)
         {
             if (arguments.context.timeout())
@@ -6622,9 +10265,9 @@ namespace shogipp
             // O肪ĂꍇATB
             if (depth >= arguments.max_selective_depth && previous_destination != npos)
             {
-                std::vector<evaluated_moves> evaluated_moves;
+                evaluated_moves_list_t evaluated_moves;
                 auto inserter = std::back_inserter(evaluated_moves);
-                const moves_t moves = state.search_moves();
+                const moves_t moves = state.nonstrict_search_moves();
                 for (const move_t & move : moves)
                 {
                     if (!move.put() && move.destination() == previous_destination)
@@ -6652,8 +10295,8 @@ namespace shogipp
             }
 
             ++details::performance.search_count();
-            const std::optional<cache_value_t> cached_value = arguments.cache.get(state.hash());
-            if (cached_value && cached_value->max_iddfs_iteration == arguments.context.max_iddfs_iteration())
+            const std::optional<cache_value_t> cached_value = arguments.transposition_table.get(state.hash());
+            if (cached_value && cached_value->cutoff(0, alpha, beta))
             {
                 ++details::performance.cache_hit_count();
                 if (usi_info)
@@ -6661,22 +10304,39 @@ namespace shogipp
                 return cached_value->evaluation_value;
             }
             const evaluation_value_t evaluation_value = evaluate(state) * reverse(state.color());
-            arguments.cache.push(state.hash(), cache_value_t{ evaluation_value, arguments.context.max_iddfs_iteration() });
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::exact, std::nullopt });
             return evaluation_value;
         }
 
-        moves_t moves = state.search_moves();
-        sort_moves_by_category(moves.begin(), moves.end());
-
-        if (moves.empty())
-            return -std::numeric_limits<evaluation_value_t>::max();
+        // u\̕]l\Ȑ[̒Tɂ̂łΒTł؂AłȂΒu\̎ŏɒTB
+        const depth_t draft = arguments.max_depth - depth; // c̒T[
+        const evaluation_value_t original_alpha = alpha;
+        const search_count_t repetition_count = arguments.repetition_count;
+        std::optional<move_t> hash_move;
+        if (const std::optional<cache_value_t> cached_value = arguments.transposition_table.get(state.hash()))
+        {
+            if (depth > 0 && cached_value->cutoff(draft, alpha, beta))
+            {
+                ++details::performance.cache_hit_count();
+                if (usi_info)
+                    usi_info->increase_cache_hit_count();
+                return cached_value->evaluation_value;
+            }
+            hash_move = cached_value->best_move;
+        }
 
-        std::vector<evaluated_moves> evaluated_moves;
+        move_picker_t move_picker{ state, hash_move, arguments.killer_table.get(depth) };
+        evaluated_moves_list_t evaluated_moves;
         auto inserter = std::back_inserter(evaluated_moves);
         evaluation_value_t max_evaluation_value = -std::numeric_limits<evaluation_value_t>::max();
 
-        for (const move_t & move : moves)
+        while (const move_t * const next_move = move_picker.next())
         {
+            const move_t & move = *next_move;
+
+            // ϐ̏ꍇAߋƓ̋ǖʂɎ̋ǖʂőIȂB
+            if (depth == 0 && state.anti_repetition_of_moves && state.is_repetition_move(move))
+                continue;
             if (usi_info && depth == 0)
                 usi_info->notify_currmove(move);
 
@@ -6698,13 +10358,26 @@ namespace shogipp
 
             alpha = std::max(alpha, evaluation_value);
             if (alpha >= beta)
+            {
+                if (move.put() || move.destination_piece().empty())
+                    arguments.killer_table.push(depth, move);
                 break;
+            }
         }
 
-        SHOGIPP_ASSERT(!moves.empty());
+        if (evaluated_moves.empty())
+            return -std::numeric_limits<evaluation_value_t>::max();
+
         sort_moves_by_evaluation_value(evaluated_moves.begin(), evaluated_moves.end());
-        candidate_move = *evaluated_moves.front().first;
-        return evaluated_moves.front().second;
+        const move_t & best_move = *evaluated_moves.front().first;
+        const evaluation_value_t evaluation_value = evaluated_moves.front().second;
+        // ̕]l͋ǖʂɎoHɈˑ邽߁AɊÂ]l͋L^Au\݂̎̂L^B
+        if (arguments.repetition_count == repetition_count)
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, draft, cache_value_t::make_bound(evaluation_value, original_alpha, beta), best_move });
+        else
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::none, best_move });
+        candidate_move = best_move;
+        return evaluation_value;
     }
 
     move_t extendable_alphabeta_evaluator_t::query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration)
@@ -6716,7 +10389,8 @@ namespace shogipp
         evaluation_value_t evaluation_value;
         const depth_t max_depth = iddfs_iteration * 2 + 1;
         const depth_t max_selective_depth = std::numeric_limits<depth_t>::max();
-        arguments_t arguments{ context.cache(), context, max_depth, max_selective_depth };
+        killer_table_t killer_table;
+        arguments_t arguments{ context.transposition_table(), context, killer_table, max_depth, max_selective_depth };
 
         try
         {
@@ -6751,9 +10425,11 @@ namespace shogipp
         class arguments_t
         {
         public:
-            cache_t & cache;
+            transposition_table_t & transposition_table;
             iddfs_context_t & context;
+            killer_table_t & killer_table;
             const pruning_threshold_t pruning_threshold{};
+            search_count_t repetition_count{};  // ̒TŐɂ]ǖʐ(u\ɕ]lL^Ă悢̔Ɏgp)
         };
 
         evaluation_value_t pruning_alphabeta(
@@ -6785,6 +10461,15 @@ namespace shogipp
         if (usi_info)
             usi_info->resolve_request_to_stop(depth);
 
+        // ͍@𐶐ɕ]B
+        if (depth > 0)
+            if (const repetition_state_t repetition_state = state.repetition_state(); repetition_state != repetition_state_t::none)
+            {
+                ++details::performance.repetition_count();
+                ++arguments.repetition_count;
+                return repetition_evaluation_value(repetition_state);
+            }
+
         // [xłA}p[^臒lȏłꍇAǖʂ̕]lԂB
         if (depth % 2 == 1 && pruning_parameter >= arguments.pruning_threshold)
         {
@@ -6792,8 +10477,8 @@ namespace shogipp
                 throw timeout_exception{ "context.timeout() == true" };
 
             ++details::performance.search_count();
-            const std::optional<cache_value_t> cached_value = arguments.cache.get(state.hash());
-            if (cached_value && cached_value->max_iddfs_iteration == arguments.context.max_iddfs_iteration())
+            const std::optional<cache_value_t> cached_value = arguments.transposition_table.get(state.hash());
+            if (cached_value && cached_value->cutoff(0, alpha, beta))
             {
                 ++details::performance.cache_hit_count();
                 if (usi_info)
@@ -6801,22 +10486,39 @@ namespace shogipp
                 return cached_value->evaluation_value;
             }
             const evaluation_value_t evaluation_value = evaluate(state) * reverse(state.color());
-            arguments.cache.push(state.hash(), cache_value_t{ evaluation_value, arguments.context.max_iddfs_iteration() });
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::exact, std::nullopt });
             return evaluation_value;
         }
 
-        moves_t moves = state.search_moves();
-        sort_moves_by_category(moves.begin(), moves.end());
-
-        if (moves.empty())
-            return -std::numeric_limits<evaluation_value_t>::max();
+        // u\̕]l\Ȑ[̒Tɂ̂łΒTł؂AłȂΒu\̎ŏɒTB
+        const depth_t draft = pruning_parameter < arguments.pruning_threshold ? arguments.pruning_threshold - pruning_parameter : 0; // }p[^臒lɒB܂ł̎c
+        const evaluation_value_t original_alpha = alpha;
+        const search_count_t repetition_count = arguments.repetition_count;
+        std::optional<move_t> hash_move;
+        if (const std::optional<cache_value_t> cached_value = arguments.transposition_table.get(state.hash()))
+        {
+            if (depth > 0 && cached_value->cutoff(draft, alpha, beta))
+            {
+                ++details::performance.cache_hit_count();
+                if (usi_info)
+                    usi_info->increase_cache_hit_count();
+                return cached_value->evaluation_value;
+            }
+            hash_move = cached_value->best_move;
+        }
 
-        std::vector<evaluated_moves> evaluated_moves;
+        move_picker_t move_picker{ state, hash_move, arguments.killer_table.get(depth) };
+        evaluated_moves_list_t evaluated_moves;
         auto inserter = std::back_inserter(evaluated_moves);
         evaluation_value_t max_evaluation_value = -std::numeric_limits<evaluation_value_t>::max();
 
-        for (const move_t & move : moves)
+        while (const move_t * const next_move = move_picker.next())
         {
+            const move_t & move = *next_move;
+
+            // ϐ̏ꍇAߋƓ̋ǖʂɎ̋ǖʂőIȂB
+            if (depth == 0 && state.anti_repetition_of_moves && state.is_repetition_move(move))
+                continue;
             if (usi_info && depth == 0)
                 usi_info->notify_currmove(move);
 
@@ -6839,13 +10541,26 @@ namespace shogipp
 
             alpha = std::max(alpha, evaluation_value);
             if (alpha >= beta)
+            {
+                if (move.put() || move.destination_piece().empty())
+                    arguments.killer_table.push(depth, move);
                 break;
+            }
         }
 
-        SHOGIPP_ASSERT(!moves.empty());
+        if (evaluated_moves.empty())
+            return -std::numeric_limits<evaluation_value_t>::max();
+
         sort_moves_by_evaluation_value(evaluated_moves.begin(), evaluated_moves.end());
-        candidate_move = *evaluated_moves.front().first;
-        return evaluated_moves.front().second;
+        const move_t & best_move = *evaluated_moves.front().first;
+        const evaluation_value_t evaluation_value = evaluated_moves.front().second;
+        // ̕]l͋ǖʂɎoHɈˑ邽߁AɊÂ]l͋L^Au\݂̎̂L^B
+        if (arguments.repetition_count == repetition_count)
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, draft, cache_value_t::make_bound(evaluation_value, original_alpha, beta), best_move });
+        else
+            arguments.transposition_table.push(state.hash(), cache_value_t{ evaluation_value, 0, bound_t::none, best_move });
+        candidate_move = best_move;
+        return evaluation_value;
     }
 
     move_t pruning_alphabeta_evaluator_t::query_best_move(state_t & state, iddfs_context_t & context, iddfs_iteration_t iddfs_iteration)
@@ -6855,7 +10570,8 @@ namespace shogipp
 
         std::optional<move_t> candidate_move;
         evaluation_value_t evaluation_value;
-        arguments_t arguments{ context.cache(), context, get_pruning_threshold() * iddfs_iteration };
+        killer_table_t killer_table;
+        arguments_t arguments{ context.transposition_table(), context, killer_table, get_pruning_threshold() * iddfs_iteration };
 
         try
         {
@@ -6882,6 +10598,8 @@ namespace shogipp
         : public abstract_evaluator_t
     {
     public:
+        bool supports_lazy_smp() const override { return false; }
+
         /**
          * @breif ǖʂɑ΂ĕ]lłȂ鍇@IB
          * @param state ǖ
@@ -6891,7 +10609,7 @@ namespace shogipp
         {
             moves_t moves = state.search_moves();
 
-            std::vector<evaluated_moves> scores;
+            evaluated_moves_list_t scores;
             auto back_inserter = std::back_inserter(scores);
             for (const move_t & move : moves)
             {
@@ -6935,6 +10653,11 @@ namespace shogipp
         {
             ;
         }
+
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<sample_evaluator_t>();
+        }
     };
 
     /**
@@ -7010,6 +10733,11 @@ namespace shogipp
             state.add_observer(m_observer);
         }
 
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<hiyoko_evaluator_t>();
+        }
+
     private:
         std::shared_ptr<difference_based_piece_evaluator_t> m_observer;
     };
@@ -7034,6 +10762,11 @@ namespace shogipp
             state.add_observer(m_observer);
         }
 
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<niwatori_evaluator_t>();
+        }
+
     private:
         std::shared_ptr<difference_based_piece_evaluator_t> m_observer;
     };
@@ -7051,18 +10784,15 @@ namespace shogipp
             evaluation_value_t evaluation_value = 0;
             evaluation_value += m_observer->evaluate();
 
-            for (position_t position = position_begin; position < position_end; ++position)
+            for (const color_t color : colors)
             {
-                if (!board_t::out(position) && !state.board[position].empty())
+                bitboard_t sources = state.occupancy(color);
+                while (!sources.empty())
                 {
-                    std::vector<kiki_t> kiki_list;
-                    const color_t color = state.board[position].to_color();
-                    state.search_kiki(std::back_inserter(kiki_list), position, color);
-                    evaluation_value += kiki_point * static_cast<evaluation_value_t>(kiki_list.size()) * reverse(color);
+                    const position_t position = sources.pop();
+                    evaluation_value += kiki_point * static_cast<evaluation_value_t>(state.count_kiki(position, color)) * reverse(color);
 
-                    std::vector<position_t> himo_list;
-                    state.search_himo(std::back_inserter(himo_list), position, color);
-                    evaluation_value += himo_point * static_cast<evaluation_value_t>(himo_list.size()) * reverse(color);
+                    evaluation_value += himo_point * static_cast<evaluation_value_t>(state.count_himo(position, color)) * reverse(color);
 
                     std::vector<position_t> destination_list;
                     state.search_destination(std::back_inserter(destination_list), position, color);
@@ -7084,6 +10814,11 @@ namespace shogipp
             state.add_observer(m_observer);
         }
 
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<fukayomi_evaluator_t>();
+        }
+
     private:
         std::shared_ptr<difference_based_piece_evaluator_t> m_observer;
     };
@@ -7101,17 +10836,14 @@ namespace shogipp
             evaluation_value_t evaluation_value = 0;
             evaluation_value += m_observer->evaluate();
 
-            for (position_t position = position_begin; position < position_end; ++position)
+            for (const color_t color : colors)
             {
-                if (!board_t::out(position) && !state.board[position].empty())
+                bitboard_t sources = state.occupancy(color);
+                while (!sources.empty())
                 {
-                    std::vector<kiki_t> kiki_list;
-                    const color_t color = state.board[position].to_color();
-                    state.search_kiki(std::back_inserter(kiki_list), position, color);
-                    evaluation_value += kiki_point * static_cast<evaluation_value_t>(kiki_list.size()) * reverse(color);
-                    std::vector<position_t> himo_list;
-                    state.search_himo(std::back_inserter(himo_list), position, color);
-                    evaluation_value += himo_point * static_cast<evaluation_value_t>(himo_list.size()) * reverse(color);
+                    const position_t position = sources.pop();
+                    evaluation_value += kiki_point * static_cast<evaluation_value_t>(state.count_kiki(position, color)) * reverse(color);
+                    evaluation_value += himo_point * static_cast<evaluation_value_t>(state.count_himo(position, color)) * reverse(color);
 
                     std::vector<position_t> destination_list;
                     state.search_destination(std::back_inserter(destination_list), position, color);
@@ -7133,6 +10865,11 @@ namespace shogipp
             state.add_observer(m_observer);
         }
 
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<edagari_evaluator_t>();
+        }
+
     private:
         std::shared_ptr<difference_based_piece_evaluator_t> m_observer;
     };
@@ -7333,13 +11070,6 @@ namespace shogipp
         {
             evaluation_value_t evaluation_value = 0;
 
-            for (position_t position = position_begin; position < position_end; ++position)
-            {
-                const colored_piece_t piece = state.board[position];
-                if (!board_t::out(position) && !piece.empty())
-                    evaluation_value += evaluate_board_piece(noncolored_piece_t{ piece }) * reverse(piece.to_color());
-            }
-
             for (const color_t color : colors)
             {
                 for (piece_value_t piece = pawn_value; piece <= rook_value; ++piece)
@@ -7352,39 +11082,33 @@ namespace shogipp
                 }
             }
 
-            for (position_t position = position_begin; position < position_end; ++position)
+            bitboard_t sources = state.occupancy();
+            while (!sources.empty())
             {
-                if (!board_t::out(position))
-                {
-                    const colored_piece_t piece = state.board[position];
-                    if (!piece.empty())
-                    {
-                        const color_t color = piece.to_color();
+                const position_t position = sources.pop();
+                const colored_piece_t piece = state.board[position];
+                const color_t color = piece.to_color();
 
-                        {
-                            std::vector<kiki_t> kiki_list;
-                            state.search_kiki(std::back_inserter(kiki_list), position, color);
-                            const std::size_t offset = std::min(kiki_list.size(), std::size(kiki_coefficient) - 1);
-                            evaluation_value += (evaluate_board_piece(piece) * reverse(color)
-                                * kiki_coefficient[offset]) >> CHAR_BIT;
-                        }
+                evaluation_value += evaluate_board_piece(noncolored_piece_t{ piece }) * reverse(color);
 
-                        {
-                            std::vector<position_t> himo_list;
-                            state.search_himo(std::back_inserter(himo_list), position, color);
-                            const std::size_t offset = std::min(himo_list.size(), std::size(himo_coefficient) - 1);
-                            evaluation_value += (evaluate_board_piece(piece) * reverse(color)
-                                * himo_coefficient[offset]) >> CHAR_BIT;
-                        }
+                {
+                    const std::size_t offset = std::min(state.count_kiki(position, color), std::size(kiki_coefficient) - 1);
+                    evaluation_value += (evaluate_board_piece(piece) * reverse(color)
+                        * kiki_coefficient[offset]) >> CHAR_BIT;
+                }
 
-                        {
-                            std::vector<position_t> destination_list;
-                            state.search_destination(std::back_inserter(destination_list), position, color);
-                            const std::size_t offset = std::min(destination_list.size(), std::size(destination_points) - 1);
-                            evaluation_value += (static_cast<evaluation_value_t>(destination_list.size()) * reverse(color)
-                                * destination_points[offset]) >> (sizeof(*destination_points) * CHAR_BIT);
-                        }
-                    }
+                {
+                    const std::size_t offset = std::min(state.count_himo(position, color), std::size(himo_coefficient) - 1);
+                    evaluation_value += (evaluate_board_piece(piece) * reverse(color)
+                        * himo_coefficient[offset]) >> CHAR_BIT;
+                }
+
+                {
+                    std::vector<position_t> destination_list;
+                    state.search_destination(std::back_inserter(destination_list), position, color);
+                    const std::size_t offset = std::min(destination_list.size(), std::size(destination_points) - 1);
+                    evaluation_value += (static_cast<evaluation_value_t>(destination_list.size()) * reverse(color)
+                        * destination_points[offset]) >> (sizeof(*destination_points) * CHAR_BIT);
                 }
             }
 
@@ -7442,6 +11166,11 @@ namespace shogipp
             ;
         }
 
+        std::shared_ptr<abstract_evaluator_t> clone() const override
+        {
+            return std::make_shared<chromosome_evaluator_t>(m_chromosome, m_name, m_id);
+        }
+
         std::string file_name() const
         {
             return m_name + "_" + std::to_string(m_id);
@@ -7700,6 +11429,7 @@ namespace shogipp
 
     private:
         std::shared_ptr<abstract_evaluator_t> ptr;
+        std::shared_ptr<transposition_table_t> transposition_table;    // u\(΋ǂʂĎgp)
     };
 
     command_t stdin_player_t::get_command(game_t & game)
@@ -7719,12 +11449,19 @@ namespace shogipp
 
     command_t computer_player_t::get_command(game_t & game)
     {
+        const std::size_t transposition_table_size = details::program_options::cache_size * 1024 * 1024;
+        if (!transposition_table || transposition_table->size() != transposition_table_size)
+            transposition_table = std::make_shared<transposition_table_t>(transposition_table_size);
+
         iddfs_context_t context
         {
             details::program_options::max_iddfs_iteration,
             details::program_options::limit_time,
-            details::program_options::cache_size / sizeof(hash_t),
-            ptr
+            transposition_table,
+            ptr,
+            details::program_options::thread_number,
+            details::program_options::parallel_mode,
+            details::program_options::principal_variation_search
         };
         context.start();
         return command_t{ command_t::id_t::move, ptr->best_move_iddfs(game.state, context) };
@@ -7973,6 +11710,7 @@ namespace shogipp
             std::vector<std::string> moves;
             std::shared_ptr<usi_info_t> usi_info;
             std::map<std::string, std::string> setoptions;
+            std::shared_ptr<transposition_table_t> transposition_table;    // u\(΋ǂʂĎgp)
 
             while (std::getline(std::cin, line))
             {
@@ -8032,7 +11770,8 @@ namespace shogipp
                 }
                 else if (tokens[current] == "usinewgame")
                 {
-                    ;
+                    if (transposition_table)
+                        transposition_table->clear();
                 }
                 else if (tokens[current] == "position")
                 {
@@ -8132,7 +11871,6 @@ namespace shogipp
                     else // ponder or none
                     {
                         state_t state{ position };
-                        auto evaluator = std::make_shared<hiyoko_evaluator_t>();
                         usi_info = std::make_shared<usi_info_t>();
 
                         {
@@ -8152,22 +11890,48 @@ namespace shogipp
                             usi_info->options = setoptions;
                         }
 
-                        evaluator->usi_info = usi_info;
+                        const std::string routine = usi_info->get_option("routine").value_or("hiyoko");
+                        const std::shared_ptr<abstract_evaluator_t> evaluator = make_evaluator(routine, usi_info);
+
+                        // PVS  alphabeta_evaluator_t ̒T݂̂gp邽߁AȊO routine ł͖邱ƂʒmB
+                        if (usi_info->get_option_as<bool>("PVS").value_or(false) && !std::dynamic_pointer_cast<alphabeta_evaluator_t>(evaluator))
+                        {
+                            std::lock_guard<decltype(usi_info->mutex)> lock{ usi_info->mutex };
+                            std::cout << "info string PVS is ignored by routine " << routine << "; it applies to niwatori only" << std::endl;
+                        }
+
+                        // u\͑傫ύXꂽꍇ̂ݍ\zB
+                        std::size_t cache_size = details::program_options::cache_size;
+                        const std::optional<std::size_t> cache_size_mb = usi_info->get_option_as<std::size_t>("USI_Hash");
+                        if (cache_size_mb)
+                            cache_size = *cache_size_mb;
+                        if (!transposition_table || transposition_table->size() != cache_size * 1024 * 1024)
+                            transposition_table = std::make_shared<transposition_table_t>(cache_size * 1024 * 1024);
 
-                        auto search_thread_impl = [evaluator, state, usi_info]() mutable
+                        auto search_thread_impl = [evaluator, state, usi_info, transposition_table]() mutable
                         {
                             try
                             {
-                                std::size_t cache_size = details::program_options::cache_size;
-                                const std::optional<std::size_t> cache_size_mb = usi_info->get_option_as<std::size_t>("USI_Hash");
-                                if (cache_size_mb)
-                                    cache_size = *cache_size_mb * 1000 * 1000;
+                                unsigned int thread_number = details::program_options::thread_number;
+                                const std::optional<unsigned int> usi_thread_number = usi_info->get_option_as<unsigned int>("Threads");
+                                if (usi_thread_number && *usi_thread_number > 0)
+                                    thread_number = *usi_thread_number;
+                                parallel_mode_t parallel_mode = details::program_options::parallel_mode;
+                                if (const std::optional<std::string> usi_parallel_mode = usi_info->get_option_as<std::string>("ParallelMode"))
+                                    if (const std::optional<parallel_mode_t> opt_parallel_mode = to_parallel_mode(*usi_parallel_mode))
+                                        parallel_mode = *opt_parallel_mode;
+                                bool principal_variation_search = details::program_options::principal_variation_search;
+                                if (const std::optional<bool> usi_principal_variation_search = usi_info->get_option_as<bool>("PVS"))
+                                    principal_variation_search = *usi_principal_variation_search;
                                 iddfs_context_t context
                                 {
                                     details::program_options::max_iddfs_iteration,
                                     usi_info->limit_time,
-                                    cache_size / sizeof(hash_t),
-                                    evaluator
+                                    transposition_table,
+                                    evaluator,
+                                    thread_number,
+                                    parallel_mode,
+                                    principal_variation_search
                                 };
                                 context.start();
                                 evaluator->best_move_iddfs(state, context);
@@ -8213,7 +11977,7 @@ namespace shogipp
                         {
                             std::lock_guard<decltype(usi_info->mutex)> lock{ usi_info->mutex };
                             best_move = usi_info->best_move;
-                            usi_info->state = usi_info_t::state_t::requested_to_stop;
+                            usi_info->request_to_stop();
                         }
                         usi_info = std::make_shared<usi_info_t>();
 
@@ -8268,6 +12032,31 @@ namespace shogipp
         virtual void ready() = 0;
 
     private:
+        /**
+         * @breif routine IvV̒l]֐IuWFNg\zB
+         * @param routine routine IvV̒l
+         * @param usi_info ]֐IuWFNgQƂ usi_info
+         * @return ]֐IuWFNg(routine sȏꍇ hiyoko)
+         */
+        inline static std::shared_ptr<abstract_evaluator_t> make_evaluator(const std::string & routine, const std::shared_ptr<usi_info_t> & usi_info)
+        {
+            if (routine == "niwatori")
+            {
+                const auto evaluator = std::make_shared<niwatori_evaluator_t>();
+                evaluator->usi_info = usi_info;
+                return evaluator;
+            }
+            if (routine == "fukayomi")
+            {
+                const auto evaluator = std::make_shared<fukayomi_evaluator_t>();
+                evaluator->usi_info = usi_info;
+                return evaluator;
+            }
+            const auto evaluator = std::make_shared<hiyoko_evaluator_t>();
+            evaluator->usi_info = usi_info;
+            return evaluator;
+        }
+
         usi_info_t m_usi_info;
     };
 
@@ -8289,7 +12078,10 @@ namespace shogipp
 
         std::string options() override
         {
-            return "option name routine type combo default hiyoko var hiyoko var niwatori var fukayomi\n";
+            return "option name routine type combo default hiyoko var hiyoko var niwatori var fukayomi\n"
+                "option name Threads type spin default " + std::to_string(details::program_options::default_thread_number) + " min 1 max 256\n"
+                "option name ParallelMode type combo default LazySMP var LazySMP var YBWC var DeterministicYBWC\n"
+                "option name PVS type check default " + std::string{ details::program_options::default_principal_variation_search ? "true" : "false" } + "\n";
         }
 
         void ready() override
@@ -8814,6 +12606,58 @@ namespace shogipp
                 }
                 else if (option == "piece-pair-statistics" && !params.empty())
                     details::program_options::piece_pair_statistics = params[0];
+                else if (option == "perft" && !params.empty())
+                {
+                    details::program_options::perft_depth = details::cast_to<move_count_t>(params[0]);
+                    if (!details::program_options::perft_depth)
+                        std::cerr << "invalid perft parameter" << std::endl;
+                }
+                else if (option == "verify-checks" && !params.empty())
+                {
+                    details::program_options::verify_checks_position_number = details::cast_to<search_count_t>(params[0]);
+                    if (!details::program_options::verify_checks_position_number)
+                        std::cerr << "invalid verify-checks parameter" << std::endl;
+                }
+                else if (option == "threads" && !params.empty())
+                {
+                    const std::optional<unsigned int> thread_number = details::cast_to<unsigned int>(params[0]);
+                    if (thread_number && *thread_number > 0)
+                        details::program_options::thread_number = *thread_number;
+                    else
+                        std::cerr << "invalid threads parameter" << std::endl;
+                }
+                else if (option == "parallel-mode" && !params.empty())
+                {
+                    const std::optional<parallel_mode_t> parallel_mode = to_parallel_mode(params[0]);
+                    if (parallel_mode)
+                        details::program_options::parallel_mode = *parallel_mode;
+                    else
+                        std::cerr << "invalid parallel-mode parameter" << std::endl;
+                }
+                else if (option == "pvs" && !params.empty())
+                {
+                    const std::optional<bool> value = details::to_bool(params[0]);
+                    if (value)
+                        details::program_options::principal_variation_search = *value;
+                    else
+                        std::cerr << "invalid pvs parameter" << std::endl;
+                }
+                else if (option == "perft-thread-number" && !params.empty())
+                {
+                    const std::optional<unsigned int> perft_thread_number = details::cast_to<unsigned int>(params[0]);
+                    if (perft_thread_number && *perft_thread_number > 0)
+                        details::program_options::perft_thread_number = *perft_thread_number;
+                    else
+                        std::cerr << "invalid perft-thread-number parameter" << std::endl;
+                }
+                else if (option == "perft-table-size" && !params.empty())
+                {
+                    const std::optional<std::size_t> perft_table_size = details::cast_to<std::size_t>(params[0]);
+                    if (perft_table_size)
+                        details::program_options::perft_table_size = *perft_table_size;
+                    else
+                        std::cerr << "invalid perft-table-size parameter" << std::endl;
+                }
                 else
                     std::cerr << "invalid option \"" << option << "\"" << std::endl;
             };
@@ -8884,6 +12728,16 @@ namespace shogipp
                     ga->write_file(details::program_options::ga_chromosomes_directory);
                 }
             }
+            else if (details::program_options::perft_depth)
+            {
+                const state_t state = details::program_options::sfen ? state_t{ *details::program_options::sfen } : state_t{};
+                perft(state, *details::program_options::perft_depth, details::program_options::perft_thread_number, details::program_options::perft_table_size * 1024 * 1024);
+            }
+            else if (details::program_options::verify_checks_position_number)
+            {
+                const state_t state = details::program_options::sfen ? state_t{ *details::program_options::sfen } : state_t{};
+                verify_checks(state, *details::program_options::verify_checks_position_number);
+            }
             else if (details::program_options::ga_dump_chromosome)
             {
                 const std::shared_ptr<chromosome_t> chromosome = std::make_shared<chromosome_t>();